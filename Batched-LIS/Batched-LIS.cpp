@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LongestIncreasingSubsequence.h"
+#include "ThreadPool.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long sequences = runner.int_option("--sequences", 1000000);
+    long long min_length = runner.int_option("--min-length", 8);
+    long long max_length = runner.int_option("--max-length", 64);
+    long long max_threads = runner.int_option("--max-threads", std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+    if (max_length < min_length) max_length = min_length;
+
+    // Random lengths keep the blocks uneven, which is what stealing evens out
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<long long> length(min_length, max_length);
+    std::uniform_int_distribution<int> value(0, 1000000000);
+    std::vector<size_t> offsets(1, 0);
+    offsets.reserve(sequences + 1);
+    for (long long s = 0; s < sequences; ++s) offsets.push_back(offsets.back() + length(rng));
+    std::vector<int> values(offsets.back());
+    for (auto& v : values) v = value(rng);
+
+    auto sequence = [&](size_t s) {
+        return std::span<const int>(values).subspan(offsets[s], offsets[s + 1] - offsets[s]);
+    };
+
+    std::vector<int> expected(sequences);
+    for (long long s = 0; s < sequences; ++s) expected[s] = longestIncreasingSubsequencePatience(sequence(s));
+    std::vector<int> lengths(sequences);
+
+    std::cout << sequences << " sequences of " << min_length << " to " << max_length << " elements ("
+        << values.size() << " values)\n";
+    std::cout << "-----------------------------------\n";
+    runner.set_input(std::to_string(sequences) + " sequences");
+    double items = static_cast<double>(sequences);
+
+    // One vector per call, as the single-sequence API needs
+    runner.run("memoization per sequence", [&] {
+        long long total = 0;
+        for (long long s = 0; s < sequences; ++s) {
+            std::span<const int> seq = sequence(s);
+            total += longestIncreasingSubsequenceMemoization(std::vector<int>(seq.begin(), seq.end()));
+        }
+        return total;
+        }, items);
+
+    runner.run("patience sorting per sequence", [&] {
+        long long total = 0;
+        for (long long s = 0; s < sequences; ++s) total += longestIncreasingSubsequencePatience(sequence(s));
+        return total;
+        }, items);
+
+    runner.run("batch, no pool", [&] {
+        longestIncreasingSubsequenceBatch(values, offsets, lengths);
+        return lengths[0];
+        }, items);
+    if (lengths != expected) std::cout << "Mismatch: batch disagrees with patience sorting\n";
+
+    // Powers of two up to the core count, then the core count itself
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(static_cast<int>(max_threads));
+
+    for (int threads : thread_counts) {
+        ThreadPool pool(threads);
+        runner.set_input(std::to_string(sequences) + " sequences, " + std::to_string(threads) + " threads");
+        std::fill(lengths.begin(), lengths.end(), 0);
+        runner.run("batch", [&] {
+            longestIncreasingSubsequenceBatch(values, offsets, lengths, &pool);
+            return lengths[0];
+            }, items);
+        if (lengths != expected) std::cout << "Mismatch: batch with " << threads << " threads disagrees with patience sorting\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "BenchmarkReport.h"
+
+using RecordKey = std::tuple<std::string, std::string, std::string>;
+
+// Index records by suite, algorithm and input
+std::map<RecordKey, BenchmarkRecord> index_records(const std::string& path) {
+    std::map<RecordKey, BenchmarkRecord> indexed;
+    for (BenchmarkRecord& record : read_benchmark_records(path)) {
+        RecordKey key{ record.suite, record.algorithm, record.input };
+        indexed[key] = std::move(record);
+    }
+    return indexed;
+}
+
+// "suite / algorithm [input]", the name every line of the comparison starts with
+std::string record_name(const RecordKey& key) {
+    const auto& [suite, algorithm, input] = key;
+    return suite + " / " + algorithm + (input.empty() ? "" : " [" + input + "]");
+}
+
+int main(int argc, char* argv[]) {
+    double threshold = 5.0;  // percent
+    const char* paths[2] = { nullptr, nullptr };
+    int path_count = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--threshold=", 12) == 0) {
+            threshold = std::atof(argv[i] + 12);
+        }
+        else if (path_count < 2 && argv[i][0] != '-') {
+            paths[path_count++] = argv[i];
+        }
+        else {
+            path_count = -1;
+            break;
+        }
+    }
+    if (path_count != 2) {
+        std::cerr << "Usage: " << argv[0] << " BASELINE CURRENT [--threshold=PERCENT]\n"
+            "Compares median times of two --json/--csv result files and exits with 1\n"
+            "when any benchmark got slower by more than the threshold (default 5%).\n";
+        return 2;
+    }
+
+    std::map<RecordKey, BenchmarkRecord> baseline, current;
+    try {
+        baseline = index_records(paths[0]);
+        current = index_records(paths[1]);
+    }
+    catch (const std::exception& error) {
+        std::cerr << "error: " << error.what() << "\n";
+        return 2;
+    }
+
+    int regressions = 0;
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& [key, before] : baseline) {
+        std::string name = record_name(key);
+        auto found = current.find(key);
+        if (found == current.end()) {
+            std::cout << name << ": missing from " << paths[1] << "\n";
+            continue;
+        }
+        const BenchmarkStats& a = before.stats;
+        const BenchmarkStats& b = found->second.stats;
+        double change = a.median > 0 ? 100.0 * (b.median - a.median) / a.median : 0.0;
+        bool overlap = b.median_ci_low <= a.median_ci_high && a.median_ci_low <= b.median_ci_high;
+
+        const char* verdict = "ok";
+        if (change > threshold) {
+            verdict = "REGRESSION";
+            ++regressions;
+        }
+        else if (change < -threshold) {
+            verdict = "improved";
+        }
+        std::cout << name << ": " << a.median << " ns -> " << b.median << " ns ("
+            << std::showpos << change << std::noshowpos << "%) " << verdict
+            << (overlap && change > threshold ? " (confidence intervals overlap)" : "") << "\n";
+    }
+    for (const auto& [key, after] : current) {
+        if (baseline.find(key) == baseline.end()) {
+            std::cout << record_name(key) << ": new benchmark\n";
+        }
+    }
+
+    std::cout << regressions << " regression(s) above " << threshold << "%\n";
+    return regressions > 0 ? 1 : 0;
+}
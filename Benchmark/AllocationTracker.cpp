@@ -0,0 +1,244 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+static std::atomic<bool> g_tracking{ false };
+static std::atomic<long long> g_allocations{ 0 };
+static std::atomic<long long> g_bytes{ 0 };
+static std::atomic<long long> g_live{ 0 };
+static std::atomic<long long> g_peak_live{ 0 };
+
+// Blocks allocated while a tracker exists. Frees of any other block, e.g. one
+// allocated before tracking started, leave live memory alone. A linear-probing
+// set of pointers in malloc'd storage, since it must not call operator new;
+// it is only touched while tracking, so untracked allocations keep their
+// layout and cost.
+class TrackedBlocks {
+public:
+    void clear() {
+        if (slots_) std::memset(slots_, 0, capacity_ * sizeof(void*));
+        size_ = 0;
+    }
+
+    void insert(void* ptr) {
+        if ((size_ + 1) * 2 > capacity_ && !grow()) return;
+        size_t slot = home(ptr);
+        while (slots_[slot] && slots_[slot] != ptr) slot = next(slot);
+        if (!slots_[slot]) {
+            slots_[slot] = ptr;
+            ++size_;
+        }
+    }
+
+    // Whether ptr was in the set
+    bool erase(void* ptr) {
+        if (!slots_) return false;
+        size_t slot = home(ptr);
+        while (slots_[slot] != ptr) {
+            if (!slots_[slot]) return false;
+            slot = next(slot);
+        }
+        slots_[slot] = nullptr;
+        --size_;
+        // Move back later entries of the run that the hole would strand
+        for (size_t hole = slot, later = next(slot); slots_[later]; later = next(later)) {
+            size_t wanted = home(slots_[later]);
+            bool reachable = hole <= later ? (hole < wanted && wanted <= later) : (hole < wanted || wanted <= later);
+            if (reachable) continue;
+            slots_[hole] = slots_[later];
+            slots_[later] = nullptr;
+            hole = later;
+        }
+        return true;
+    }
+
+private:
+    size_t home(void* ptr) const {
+        return static_cast<size_t>((reinterpret_cast<uintptr_t>(ptr) * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+    size_t next(size_t slot) const { return (slot + 1) & (capacity_ - 1); }
+
+    bool grow() {
+        size_t capacity = capacity_ ? capacity_ * 2 : 1024;
+        void** slots = static_cast<void**>(std::calloc(capacity, sizeof(void*)));
+        if (!slots) return false;
+        void** old = slots_;
+        size_t old_capacity = capacity_;
+        slots_ = slots;
+        capacity_ = capacity;
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+        size_ = 0;
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old[i]) insert(old[i]);
+        }
+        std::free(old);
+        return true;
+    }
+
+    void** slots_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    unsigned shift_ = 64;
+};
+
+static std::mutex g_blocks_mutex;
+static TrackedBlocks g_blocks;
+
+// Live memory is counted in usable block sizes so frees match allocations
+// even when operator delete is called without a size
+static size_t block_size(void* ptr, size_t alignment) {
+#if defined(_WIN32)
+    return alignment > alignof(std::max_align_t) ? _aligned_msize(ptr, alignment, 0) : _msize(ptr);
+#elif defined(__APPLE__)
+    (void)alignment;
+    return malloc_size(ptr);
+#else
+    (void)alignment;
+    return malloc_usable_size(ptr);
+#endif
+}
+
+static void record_allocation(void* ptr, size_t size, size_t alignment) {
+    if (!g_tracking.load(std::memory_order_relaxed) || !ptr) return;
+    {
+        std::lock_guard<std::mutex> lock(g_blocks_mutex);
+        g_blocks.insert(ptr);
+    }
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    long long block = static_cast<long long>(block_size(ptr, alignment));
+    long long live = g_live.fetch_add(block, std::memory_order_relaxed) + block;
+    long long peak = g_peak_live.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak_live.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+static void record_free(void* ptr, size_t alignment) {
+    if (!g_tracking.load(std::memory_order_relaxed) || !ptr) return;
+    {
+        std::lock_guard<std::mutex> lock(g_blocks_mutex);
+        if (!g_blocks.erase(ptr)) return;
+    }
+    g_live.fetch_sub(static_cast<long long>(block_size(ptr, alignment)), std::memory_order_relaxed);
+}
+
+static void* allocate(size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    record_allocation(ptr, size, alignof(std::max_align_t));
+    return ptr;
+}
+
+static void* allocate_aligned(size_t size, size_t alignment) {
+#if defined(_WIN32)
+    void* ptr = _aligned_malloc(size ? size : 1, alignment);
+#else
+    void* ptr = std::aligned_alloc(alignment, (std::max<size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+    record_allocation(ptr, size, alignment);
+    return ptr;
+}
+
+static void deallocate(void* ptr) {
+    record_free(ptr, alignof(std::max_align_t));
+    std::free(ptr);
+}
+
+static void deallocate_aligned(void* ptr, size_t alignment) {
+    record_free(ptr, alignment);
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocate_aligned(size, static_cast<size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocate_aligned(size, static_cast<size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { deallocate_aligned(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { deallocate_aligned(ptr, static_cast<size_t>(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { deallocate_aligned(ptr, static_cast<size_t>(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { deallocate_aligned(ptr, static_cast<size_t>(alignment)); }
+
+AllocationTracker::AllocationTracker() {
+    {
+        // Blocks counted by an earlier tracker are not this one's
+        std::lock_guard<std::mutex> lock(g_blocks_mutex);
+        g_blocks.clear();
+    }
+    g_allocations.store(0);
+    g_bytes.store(0);
+    g_live.store(0);
+    g_peak_live.store(0);
+    g_tracking.store(true);
+}
+
+AllocationTracker::~AllocationTracker() {
+    g_tracking.store(false);
+}
+
+void AllocationTracker::begin_call() {
+    call_start_live_ = g_live.load(std::memory_order_relaxed);
+    g_peak_live.store(call_start_live_, std::memory_order_relaxed);
+}
+
+void AllocationTracker::end_call() {
+    ++calls_;
+    peak_growth_ = std::max(peak_growth_, g_peak_live.load(std::memory_order_relaxed) - call_start_live_);
+}
+
+AllocationStats AllocationTracker::per_call() const {
+    AllocationStats stats;
+    if (calls_ == 0) return stats;
+    stats.allocations = static_cast<double>(g_allocations.load()) / calls_;
+    stats.bytes = static_cast<double>(g_bytes.load()) / calls_;
+    stats.peak_bytes = static_cast<double>(peak_growth_);
+    return stats;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Heap traffic per benchmarked call
+struct AllocationStats {
+    double allocations = 0;  // operator new calls
+    double bytes = 0;        // bytes requested from operator new
+    double peak_bytes = 0;   // largest growth of live heap memory during one call
+};
+
+// Counts every global operator new/delete while alive. The replacement
+// operators live in AllocationTracker.cpp and only count while a tracker
+// exists, so untracked code pays one relaxed atomic load per allocation. While
+// tracking, the blocks it counted are kept in a side table, so freeing memory
+// allocated before the tracker started leaves live bytes unchanged.
+class AllocationTracker {
+public:
+    AllocationTracker();
+    ~AllocationTracker();
+
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+    // Bracket one call so its peak live memory can be measured
+    void begin_call();
+    void end_call();
+
+    // Totals since construction divided by the number of bracketed calls
+    AllocationStats per_call() const;
+
+private:
+    long long calls_ = 0;
+    long long call_start_live_ = 0;
+    long long peak_growth_ = 0;
+};
@@ -0,0 +1,245 @@
+#include "Benchmark.h"
+#include "BenchmarkReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+double clock_resolution_ns() {
+    static const double resolution = [] {
+        double smallest = 1e9;
+        for (int i = 0; i < 100; ++i) {
+            auto start = BenchmarkClock::now();
+            auto next = BenchmarkClock::now();
+            while (next == start) {
+                next = BenchmarkClock::now();
+            }
+            smallest = std::min(smallest, std::chrono::duration<double, std::nano>(next - start).count());
+        }
+        return smallest;
+    }();
+    return resolution;
+}
+
+double default_min_batch_ns() {
+    // 1000 ticks keep the quantisation error of a batch below 0.1%
+    return std::max(1000.0 * clock_resolution_ns(), 1000000.0);
+}
+
+int budgeted_batches(const BenchmarkOptions& options, double batch_ns) {
+    double budget = options.max_seconds * 1e9 / (batch_ns > 0 ? batch_ns : 1);
+    if (budget >= options.batches) return options.batches;
+    return std::min(options.batches, std::max(5, static_cast<int>(budget)));
+}
+
+// Linear interpolation between closest ranks of sorted data
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.size() == 1) return sorted[0];
+    double rank = p * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(rank);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (rank - lower) * (sorted[upper] - sorted[lower]);
+}
+
+// Two-sided 95% critical value of Student's t distribution
+static double t_critical_95(int df) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    if (df <= 0) return 0;
+    if (df <= 30) return table[df - 1];
+    return 1.96 + 2.4 / df;
+}
+
+BenchmarkStats summarize(std::vector<double> per_call_ns, long long calls_per_batch) {
+    BenchmarkStats stats;
+    stats.calls_per_batch = calls_per_batch;
+    stats.batches = static_cast<int>(per_call_ns.size());
+    if (per_call_ns.empty()) return stats;
+
+    std::sort(per_call_ns.begin(), per_call_ns.end());
+    int n = stats.batches;
+    stats.min = per_call_ns.front();
+    stats.max = per_call_ns.back();
+    stats.mean = std::accumulate(per_call_ns.begin(), per_call_ns.end(), 0.0) / n;
+    stats.median = percentile(per_call_ns, 0.5);
+    stats.p50 = stats.median;
+    stats.p90 = percentile(per_call_ns, 0.9);
+    stats.p99 = percentile(per_call_ns, 0.99);
+
+    double squares = 0;
+    for (double sample : per_call_ns) {
+        squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+
+    double margin = t_critical_95(n - 1) * stats.stddev / std::sqrt(static_cast<double>(n));
+    stats.mean_ci_low = stats.mean - margin;
+    stats.mean_ci_high = stats.mean + margin;
+
+    // Ranks n/2 -+ 1.96 * sqrt(n)/2 bracket the median with ~95% confidence
+    double spread = 0.98 * std::sqrt(static_cast<double>(n));
+    int low = std::max(0, static_cast<int>(std::floor(n / 2.0 - spread)) - 1);
+    int high = std::min(n - 1, static_cast<int>(std::ceil(n / 2.0 + spread)));
+    stats.median_ci_low = per_call_ns[low];
+    stats.median_ci_high = per_call_ns[high];
+    return stats;
+}
+
+// Parse "--name=value" arguments
+static bool parse_option(const char* arg, const char* name, const char*& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) == 0 && arg[length] == '=') {
+        value = arg + length + 1;
+        return true;
+    }
+    return false;
+}
+
+BenchmarkRunner::BenchmarkRunner(int argc, char* argv[]) {
+    // The executable name identifies the suite in machine-readable output
+    suite_ = argc > 0 ? argv[0] : "benchmark";
+    suite_ = suite_.substr(suite_.find_last_of("/\\") + 1);
+    if (suite_.size() > 4 && suite_.compare(suite_.size() - 4, 4, ".exe") == 0) {
+        suite_.resize(suite_.size() - 4);
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+        if (parse_option(argv[i], "--batches", value)) {
+            options_.batches = std::max(1, std::atoi(value));
+        }
+        else if (parse_option(argv[i], "--warmup", value)) {
+            options_.warmup_batches = std::max(0, std::atoi(value));
+        }
+        else if (parse_option(argv[i], "--min-batch-ns", value)) {
+            options_.min_batch_ns = std::atof(value);
+        }
+        else if (parse_option(argv[i], "--max-seconds", value)) {
+            options_.max_seconds = std::atof(value);
+        }
+        else if (parse_option(argv[i], "--json", value)) {
+            json_path_ = value;
+        }
+        else if (parse_option(argv[i], "--csv", value)) {
+            csv_path_ = value;
+        }
+        else if (std::strcmp(argv[i], "--perf") == 0) {
+            counters_ = std::make_unique<PerfCounters>();
+            if (!counters_->available()) {
+                std::cerr << "Hardware counters unavailable, reporting timings only: " << counters_->error() << "\n";
+                counters_.reset();
+            }
+        }
+        else if (std::strcmp(argv[i], "--allocations") == 0) {
+            track_allocations_ = true;
+        }
+        else if (std::strcmp(argv[i], "--help") == 0) {
+            std::cout << "Usage: " << argv[0] << " [--batches=N] [--warmup=N] [--min-batch-ns=NS] [--max-seconds=S]"
+                " [--json=FILE] [--csv=FILE] [--perf] [--allocations]\n";
+            std::exit(0);
+        }
+        else {
+            // May be claimed later through int_option()
+            unclaimed_options_.push_back(argv[i]);
+        }
+    }
+}
+
+long long BenchmarkRunner::int_option(const std::string& name, long long fallback) {
+    for (auto option = unclaimed_options_.begin(); option != unclaimed_options_.end(); ++option) {
+        const char* value = nullptr;
+        if (parse_option(option->c_str(), name.c_str(), value)) {
+            long long parsed = std::atoll(value);
+            unclaimed_options_.erase(option);
+            return parsed;
+        }
+    }
+    return fallback;
+}
+
+BenchmarkRunner::~BenchmarkRunner() {
+    for (const std::string& option : unclaimed_options_) {
+        std::cerr << "Ignored unknown option " << option << "\n";
+    }
+    if (json_path_.empty() && csv_path_.empty()) return;
+
+    RunMetadata metadata = collect_run_metadata();
+    for (BenchmarkRecord& record : records_) {
+        record.metadata = metadata;
+    }
+    if (!json_path_.empty()) {
+        std::ofstream out(json_path_);
+        write_json(out, records_);
+        if (!out) std::cerr << "Could not write " << json_path_ << "\n";
+    }
+    if (!csv_path_.empty()) {
+        std::ofstream out(csv_path_);
+        write_csv(out, records_);
+        if (!out) std::cerr << "Could not write " << csv_path_ << "\n";
+    }
+}
+
+void BenchmarkRunner::report(const std::string& name, const BenchmarkStats& stats, const AllocationStats& allocations,
+    double items_per_call) {
+    BenchmarkRecord record;
+    record.suite = suite_;
+    record.algorithm = name;
+    record.input = input_;
+    record.stats = stats;
+
+    std::ios state(nullptr);
+    state.copyfmt(std::cout);
+    std::cout << std::fixed << std::setprecision(1)
+        << "Time for " << name << ": median " << stats.median << " ns"
+        << " (95% CI " << stats.median_ci_low << "-" << stats.median_ci_high << ")"
+        << ", mean " << stats.mean << " +- " << (stats.mean_ci_high - stats.mean)
+        << ", stddev " << stats.stddev
+        << ", p50/p90/p99 " << stats.p50 << "/" << stats.p90 << "/" << stats.p99
+        << " [" << stats.batches << " batches x " << stats.calls_per_batch << " calls]\n";
+
+    if (items_per_call > 0 && stats.median > 0) {
+        double items_per_second = items_per_call * 1e9 / stats.median;
+        record.metrics["items_per_call"] = items_per_call;
+        record.metrics["items_per_second"] = items_per_second;
+        std::cout << "    throughput: " << std::setprecision(2);
+        if (items_per_second >= 1e6) {
+            std::cout << items_per_second / 1e6 << " M items/s (";
+        }
+        else {
+            std::cout << items_per_second << " items/s (";
+        }
+        std::cout << std::setprecision(0)
+            << items_per_call << " items per call, " << std::setprecision(3)
+            << stats.median / items_per_call << " ns each)\n";
+    }
+    if (counters_) {
+        PerfCounterValues per_call = counters_->read(static_cast<double>(stats.batches) * stats.calls_per_batch);
+        record.metrics["cycles"] = per_call.cycles;
+        record.metrics["instructions"] = per_call.instructions;
+        record.metrics["ipc"] = per_call.ipc();
+        record.metrics["l1d_misses"] = per_call.l1d_misses;
+        record.metrics["llc_misses"] = per_call.llc_misses;
+        record.metrics["branch_misses"] = per_call.branch_misses;
+        std::cout << std::setprecision(2)
+            << "    per call: " << per_call.cycles << " cycles, " << per_call.instructions << " instructions"
+            << ", IPC " << per_call.ipc() << ", " << per_call.l1d_misses << " L1D misses"
+            << ", " << per_call.llc_misses << " LLC misses, " << per_call.branch_misses << " branch misses\n";
+    }
+    if (track_allocations_) {
+        record.metrics["allocations"] = allocations.allocations;
+        record.metrics["allocated_bytes"] = allocations.bytes;
+        record.metrics["peak_bytes"] = allocations.peak_bytes;
+        std::cout << std::setprecision(1)
+            << "    per call: " << allocations.allocations << " allocations, " << allocations.bytes
+            << " bytes allocated, peak " << allocations.peak_bytes << " bytes live\n";
+    }
+    std::cout.copyfmt(state);
+    records_.push_back(record);
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "AllocationTracker.h"
+#include "PerfCounters.h"
+
+// Keep the compiler from discarding a value (or the work that produced it)
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const volatile void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+    else {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+#endif
+}
+
+// Same for a variable, which the compiler must also assume was changed, so work
+// computed from an input passed through here is not hoisted out of the timed loop
+template <typename T>
+inline void do_not_optimize(T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static volatile void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#else
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+        asm volatile("" : "+r,m"(value) : : "memory");
+    }
+    else {
+        asm volatile("" : "+m"(value) : : "memory");
+    }
+#endif
+}
+
+// Force pending writes to memory and make the compiler assume memory changed
+inline void clobber_memory() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct BenchmarkOptions {
+    int warmup_batches = 3;
+    int batches = 31;
+    double min_batch_ns = 0;  // 0 picks a batch length well above the clock resolution
+    double max_seconds = 10;  // slow variants run fewer batches (at least 5) to fit this budget
+};
+
+// Per-call statistics over all timed batches, in nanoseconds
+struct BenchmarkStats {
+    double mean = 0;
+    double median = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double stddev = 0;
+    double min = 0;
+    double max = 0;
+    double mean_ci_low = 0;     // 95% confidence interval of the mean (Student t)
+    double mean_ci_high = 0;
+    double median_ci_low = 0;   // 95% confidence interval of the median (order statistics)
+    double median_ci_high = 0;
+    long long calls_per_batch = 0;
+    int batches = 0;
+};
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Smallest observable tick of BenchmarkClock
+double clock_resolution_ns();
+
+// Batch length used when BenchmarkOptions::min_batch_ns is 0
+double default_min_batch_ns();
+
+// Number of batches that fits options.max_seconds, given the length of one batch
+int budgeted_batches(const BenchmarkOptions& options, double batch_ns);
+
+// Reduce the per-call time of every batch to summary statistics
+BenchmarkStats summarize(std::vector<double> per_call_ns, long long calls_per_batch);
+
+// Time one batch of calls and return the elapsed nanoseconds
+template <typename Func>
+double time_batch(Func& func, long long calls) {
+    do_not_optimize(func);
+    auto start = BenchmarkClock::now();
+    for (long long i = 0; i < calls; ++i) {
+        if constexpr (std::is_void_v<decltype(func())>) {
+            func();
+            clobber_memory();
+        }
+        else {
+            do_not_optimize(func());
+        }
+    }
+    auto end = BenchmarkClock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Find how many calls are needed for one batch to last at least min_batch_ns
+template <typename Func>
+long long calibrate_batch(Func& func, double min_batch_ns) {
+    long long calls = 1;
+    while (true) {
+        double elapsed = time_batch(func, calls);
+        if (elapsed >= min_batch_ns) {
+            return calls;
+        }
+        // Jump close to the target, but never grow by more than 10x in one step
+        double factor = elapsed > 0 ? 1.2 * min_batch_ns / elapsed : 10.0;
+        calls = static_cast<long long>(calls * (factor < 10.0 ? (factor > 2.0 ? factor : 2.0) : 10.0));
+    }
+}
+
+// Warm up, calibrate the batch size and time options.batches batches of func.
+// When counters are given they run during the timed batches only.
+template <typename Func>
+BenchmarkStats measure(Func&& func, const BenchmarkOptions& options = {}, PerfCounters* counters = nullptr) {
+    double min_batch_ns = options.min_batch_ns > 0 ? options.min_batch_ns : default_min_batch_ns();
+    long long calls = calibrate_batch(func, min_batch_ns);
+    double batch_ns = time_batch(func, calls);
+    int batches = budgeted_batches(options, batch_ns);
+    // The batch above is the first warm-up; slow variants get no more
+    int warmups = batches < options.batches ? 1 : options.warmup_batches;
+    for (int i = 1; i < warmups; ++i) {
+        time_batch(func, calls);
+    }
+    std::vector<double> per_call_ns;
+    per_call_ns.reserve(batches);
+    if (counters) counters->start();
+    for (int i = 0; i < batches; ++i) {
+        per_call_ns.push_back(time_batch(func, calls) / calls);
+    }
+    if (counters) counters->stop();
+    return summarize(std::move(per_call_ns), calls);
+}
+
+// Count heap traffic over a separate, untimed batch of calls
+template <typename Func>
+AllocationStats measure_allocations(Func&& func, long long calls) {
+    AllocationTracker tracker;
+    for (long long i = 0; i < calls; ++i) {
+        tracker.begin_call();
+        if constexpr (std::is_void_v<decltype(func())>) {
+            func();
+            clobber_memory();
+        }
+        else {
+            do_not_optimize(func());
+        }
+        tracker.end_call();
+    }
+    return tracker.per_call();
+}
+
+struct BenchmarkRecord;
+
+// Command-line driven benchmark front end shared by the examples.
+// Results are printed as text and, with --json=FILE or --csv=FILE, written
+// to machine-readable files when the runner goes out of scope. --perf adds
+// hardware counters per call when the platform provides them and
+// --allocations adds heap allocations, bytes and peak live memory per call.
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(int argc, char* argv[]);
+    ~BenchmarkRunner();
+
+    BenchmarkRunner(const BenchmarkRunner&) = delete;
+    BenchmarkRunner& operator=(const BenchmarkRunner&) = delete;
+
+    // Label the input of the following runs, e.g. "30" or "3x3"
+    void set_input(const std::string& input) { input_ = input; }
+
+    // Time func and report it. A positive items_per_call (queries, elements,
+    // ...) also reports throughput as items per second.
+    template <typename Func>
+    BenchmarkStats run(const std::string& name, Func&& func, double items_per_call = 0) {
+        BenchmarkStats stats = measure(func, options_, counters_.get());
+        AllocationStats allocations;
+        if (track_allocations_) {
+            allocations = measure_allocations(func, stats.calls_per_batch);
+        }
+        report(name, stats, allocations, items_per_call);
+        return stats;
+    }
+
+    const BenchmarkOptions& options() const { return options_; }
+
+    // Value of an example-specific "--name=value" option
+    long long int_option(const std::string& name, long long fallback);
+
+private:
+    void report(const std::string& name, const BenchmarkStats& stats, const AllocationStats& allocations,
+        double items_per_call);
+
+    BenchmarkOptions options_;
+    std::string suite_;
+    std::string input_;
+    std::string json_path_;
+    std::string csv_path_;
+    std::vector<BenchmarkRecord> records_;
+    std::vector<std::string> unclaimed_options_;
+    std::unique_ptr<PerfCounters> counters_;
+    bool track_allocations_ = false;
+};
@@ -0,0 +1,455 @@
+#include "BenchmarkReport.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+// Generated by the CMake build; builds without it report an unknown revision
+#if __has_include("GitRevision.h")
+#include "GitRevision.h"
+#else
+#define DP_GIT_REVISION "unknown"
+#endif
+
+#ifndef DP_CXX_FLAGS
+#define DP_CXX_FLAGS "unknown"
+#endif
+#ifndef DP_BUILD_TYPE
+#define DP_BUILD_TYPE "unknown"
+#endif
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+// Processor brand string from CPUID, or the model line of /proc/cpuinfo
+static std::string cpu_model() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4] = {};
+    char brand[49] = {};
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) >= 0x80000004) {
+        for (int leaf = 0; leaf < 3; ++leaf) {
+            __cpuid(regs, 0x80000002 + leaf);
+            std::memcpy(brand + 16 * leaf, regs, sizeof(regs));
+        }
+        return trim(brand);
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    unsigned regs[4] = {};
+    char brand[49] = {};
+    if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+        for (unsigned leaf = 0; leaf < 3; ++leaf) {
+            __get_cpuid(0x80000002 + leaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+            std::memcpy(brand + 16 * leaf, regs, sizeof(regs));
+        }
+        return trim(brand);
+    }
+#endif
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0 || line.rfind("Model", 0) == 0) {
+            return trim(line.substr(line.find(':') + 1));
+        }
+    }
+    return "unknown";
+}
+
+static std::string compiler_version() {
+#if defined(__clang__)
+    return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+static std::string utc_timestamp() {
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#if defined(_WIN32)
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buffer;
+}
+
+RunMetadata collect_run_metadata() {
+    RunMetadata metadata;
+    metadata.cpu_model = cpu_model();
+    metadata.compiler = compiler_version();
+    metadata.flags = trim(DP_CXX_FLAGS);
+    metadata.build_type = DP_BUILD_TYPE;
+    metadata.git_sha = DP_GIT_REVISION;
+    metadata.timestamp = utc_timestamp();
+    return metadata;
+}
+
+// A named column of a record; numbers are written unquoted in JSON
+struct Field {
+    std::string name;
+    std::string value;
+    bool numeric;
+};
+
+static std::string format_number(double value) {
+    if (!std::isfinite(value)) return "";
+    std::ostringstream out;
+    out << std::setprecision(10) << value;
+    return out.str();
+}
+
+static std::vector<Field> record_fields(const BenchmarkRecord& record) {
+    const BenchmarkStats& s = record.stats;
+    std::vector<Field> fields = {
+        { "suite", record.suite, false },
+        { "algorithm", record.algorithm, false },
+        { "input", record.input, false },
+        { "median_ns", format_number(s.median), true },
+        { "mean_ns", format_number(s.mean), true },
+        { "p50_ns", format_number(s.p50), true },
+        { "p90_ns", format_number(s.p90), true },
+        { "p99_ns", format_number(s.p99), true },
+        { "stddev_ns", format_number(s.stddev), true },
+        { "min_ns", format_number(s.min), true },
+        { "max_ns", format_number(s.max), true },
+        { "mean_ci_low_ns", format_number(s.mean_ci_low), true },
+        { "mean_ci_high_ns", format_number(s.mean_ci_high), true },
+        { "median_ci_low_ns", format_number(s.median_ci_low), true },
+        { "median_ci_high_ns", format_number(s.median_ci_high), true },
+        { "calls_per_batch", std::to_string(s.calls_per_batch), true },
+        { "batches", std::to_string(s.batches), true },
+    };
+    for (const auto& [name, value] : record.metrics) {
+        fields.push_back({ name, format_number(value), true });
+    }
+    const RunMetadata& m = record.metadata;
+    fields.push_back({ "cpu_model", m.cpu_model, false });
+    fields.push_back({ "compiler", m.compiler, false });
+    fields.push_back({ "flags", m.flags, false });
+    fields.push_back({ "build_type", m.build_type, false });
+    fields.push_back({ "git_sha", m.git_sha, false });
+    fields.push_back({ "timestamp", m.timestamp, false });
+    return fields;
+}
+
+static std::string json_escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        switch (c) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", c);
+                escaped += code;
+            }
+            else {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+
+void write_json(std::ostream& out, const std::vector<BenchmarkRecord>& records) {
+    out << "[\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        out << "  {";
+        std::vector<Field> fields = record_fields(records[i]);
+        for (size_t j = 0; j < fields.size(); ++j) {
+            out << (j ? ", " : "") << '"' << fields[j].name << "\": ";
+            if (!fields[j].numeric) {
+                out << '"' << json_escape(fields[j].value) << '"';
+            }
+            else {
+                out << (fields[j].value.empty() ? "null" : fields[j].value);
+            }
+        }
+        out << (i + 1 < records.size() ? "},\n" : "}\n");
+    }
+    out << "]\n";
+}
+
+static std::string csv_escape(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c;
+        if (c == '"') quoted += '"';
+    }
+    return quoted + "\"";
+}
+
+void write_csv(std::ostream& out, const std::vector<BenchmarkRecord>& records) {
+    // Records may carry different metrics, so the header is the union of all columns
+    std::vector<std::string> columns;
+    std::set<std::string> seen;
+    for (const BenchmarkRecord& record : records) {
+        for (const Field& field : record_fields(record)) {
+            if (seen.insert(field.name).second) {
+                columns.push_back(field.name);
+            }
+        }
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        out << (i ? "," : "") << columns[i];
+    }
+    out << "\n";
+    for (const BenchmarkRecord& record : records) {
+        std::map<std::string, std::string> values;
+        for (const Field& field : record_fields(record)) {
+            values[field.name] = field.value;
+        }
+        for (size_t i = 0; i < columns.size(); ++i) {
+            out << (i ? "," : "") << csv_escape(values[columns[i]]);
+        }
+        out << "\n";
+    }
+}
+
+static double parse_number(const std::string& text) {
+    if (text.empty()) return std::numeric_limits<double>::quiet_NaN();
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (*end != '\0') {
+        throw std::runtime_error("invalid number '" + text + "'");
+    }
+    return value;
+}
+
+static BenchmarkRecord record_from_fields(const std::map<std::string, std::string>& fields) {
+    BenchmarkRecord record;
+    BenchmarkStats& s = record.stats;
+    RunMetadata& m = record.metadata;
+    std::map<std::string, std::string*> text_fields = {
+        { "suite", &record.suite }, { "algorithm", &record.algorithm }, { "input", &record.input },
+        { "cpu_model", &m.cpu_model }, { "compiler", &m.compiler }, { "flags", &m.flags },
+        { "build_type", &m.build_type }, { "git_sha", &m.git_sha }, { "timestamp", &m.timestamp } };
+    std::map<std::string, double*> stat_fields = {
+        { "median_ns", &s.median }, { "mean_ns", &s.mean }, { "p50_ns", &s.p50 },
+        { "p90_ns", &s.p90 }, { "p99_ns", &s.p99 }, { "stddev_ns", &s.stddev },
+        { "min_ns", &s.min }, { "max_ns", &s.max },
+        { "mean_ci_low_ns", &s.mean_ci_low }, { "mean_ci_high_ns", &s.mean_ci_high },
+        { "median_ci_low_ns", &s.median_ci_low }, { "median_ci_high_ns", &s.median_ci_high } };
+
+    for (const auto& [name, value] : fields) {
+        if (auto text = text_fields.find(name); text != text_fields.end()) {
+            *text->second = value;
+        }
+        else if (auto stat = stat_fields.find(name); stat != stat_fields.end()) {
+            *stat->second = parse_number(value);
+        }
+        else if (name == "calls_per_batch") {
+            s.calls_per_batch = static_cast<long long>(parse_number(value));
+        }
+        else if (name == "batches") {
+            s.batches = static_cast<int>(parse_number(value));
+        }
+        else if (!value.empty()) {
+            record.metrics[name] = parse_number(value);
+        }
+    }
+    if (record.algorithm.empty()) {
+        throw std::runtime_error("record without an algorithm field");
+    }
+    return record;
+}
+
+// Minimal reader for the flat JSON written by write_json
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text_(text) {}
+
+    std::vector<BenchmarkRecord> read() {
+        std::vector<BenchmarkRecord> records;
+        expect('[');
+        if (peek() == ']') {
+            ++pos_;
+            return records;
+        }
+        while (true) {
+            records.push_back(record_from_fields(read_object()));
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect(']');
+            return records;
+        }
+    }
+
+private:
+    std::map<std::string, std::string> read_object() {
+        std::map<std::string, std::string> fields;
+        expect('{');
+        if (peek() == '}') {
+            ++pos_;
+            return fields;
+        }
+        while (true) {
+            std::string name = read_string();
+            expect(':');
+            fields[name] = read_value();
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect('}');
+            return fields;
+        }
+    }
+
+    std::string read_value() {
+        char c = peek();
+        if (c == '"') return read_string();
+        if (text_.compare(pos_, 4, "null") == 0) {
+            pos_ += 4;
+            return "";
+        }
+        size_t start = pos_;
+        while (pos_ < text_.size() && (std::isdigit(static_cast<unsigned char>(text_[pos_])) || std::strchr("+-.eE", text_[pos_]))) {
+            ++pos_;
+        }
+        if (start == pos_) fail("expected a value");
+        return text_.substr(start, pos_ - start);
+    }
+
+    std::string read_string() {
+        expect('"');
+        std::string value;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\' && pos_ < text_.size()) {
+                char escaped = text_[pos_++];
+                switch (escaped) {
+                case 'n': value += '\n'; break;
+                case 't': value += '\t'; break;
+                case 'u':
+                    value += static_cast<char>(std::stoi(text_.substr(pos_, 4), nullptr, 16));
+                    pos_ += 4;
+                    break;
+                default: value += escaped;
+                }
+            }
+            else {
+                value += c;
+            }
+        }
+        expect('"');
+        return value;
+    }
+
+    char peek() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    void expect(char c) {
+        if (peek() != c) fail(std::string("expected '") + c + "'");
+        ++pos_;
+    }
+
+    [[noreturn]] void fail(const std::string& message) {
+        throw std::runtime_error(message + " at offset " + std::to_string(pos_));
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+// Split one CSV line, honouring quoted fields
+static std::vector<std::string> split_csv_line(const std::string& line) {
+    std::vector<std::string> cells(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                cells.back() += '"';
+                ++i;
+            }
+            else if (c == '"') {
+                quoted = false;
+            }
+            else {
+                cells.back() += c;
+            }
+        }
+        else if (c == '"') {
+            quoted = true;
+        }
+        else if (c == ',') {
+            cells.emplace_back();
+        }
+        else if (c != '\r') {
+            cells.back() += c;
+        }
+    }
+    return cells;
+}
+
+std::vector<BenchmarkRecord> read_benchmark_records(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && text[first] == '[') {
+        return JsonReader(text).read();
+    }
+
+    std::vector<BenchmarkRecord> records;
+    std::istringstream lines(text);
+    std::string line;
+    std::vector<std::string> header;
+    while (std::getline(lines, line)) {
+        if (trim(line).empty()) continue;
+        std::vector<std::string> cells = split_csv_line(line);
+        if (header.empty()) {
+            header = cells;
+            continue;
+        }
+        if (cells.size() != header.size()) {
+            throw std::runtime_error(path + ": row has " + std::to_string(cells.size()) +
+                " cells, header has " + std::to_string(header.size()));
+        }
+        std::map<std::string, std::string> fields;
+        for (size_t i = 0; i < header.size(); ++i) {
+            fields[header[i]] = cells[i];
+        }
+        records.push_back(record_from_fields(fields));
+    }
+    return records;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+// Where and how a set of results was produced
+struct RunMetadata {
+    std::string cpu_model;
+    std::string compiler;
+    std::string flags;
+    std::string build_type;
+    std::string git_sha;
+    std::string timestamp;
+};
+
+// Describe the current machine, toolchain and revision
+RunMetadata collect_run_metadata();
+
+// One benchmarked variant on one input
+struct BenchmarkRecord {
+    std::string suite;       // executable that produced the record
+    std::string algorithm;
+    std::string input;
+    BenchmarkStats stats;
+    std::map<std::string, double> metrics;  // optional extra measurements
+    RunMetadata metadata;
+};
+
+// Write records as a JSON array of flat objects
+void write_json(std::ostream& out, const std::vector<BenchmarkRecord>& records);
+
+// Write records as CSV with a header row
+void write_csv(std::ostream& out, const std::vector<BenchmarkRecord>& records);
+
+// Read a file produced by write_json or write_csv; throws std::runtime_error on malformed input
+std::vector<BenchmarkRecord> read_benchmark_records(const std::string& path);
@@ -0,0 +1,106 @@
+#include "PerfCounters.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const double NOT_AVAILABLE = std::numeric_limits<double>::quiet_NaN();
+
+#if defined(__linux__)
+
+static int open_event(uint32_t type, uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1;  // the leader starts and stops the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+PerfCounters::PerfCounters() {
+    const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D |
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct { uint32_t type; uint64_t config; } events[EVENT_COUNT] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, l1d_read_miss },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    };
+
+    fds_[0] = open_event(events[0].type, events[0].config, -1);
+    if (fds_[0] < 0) {
+        error_ = std::string("perf_event_open failed: ") + std::strerror(errno);
+        if (errno == EACCES || errno == EPERM) {
+            error_ += " (check /proc/sys/kernel/perf_event_paranoid)";
+        }
+        for (int i = 1; i < EVENT_COUNT; ++i) fds_[i] = -1;
+        return;
+    }
+    // Members the PMU does not support stay at -1 and are reported as NaN
+    for (int i = 1; i < EVENT_COUNT; ++i) {
+        fds_[i] = open_event(events[i].type, events[i].config, fds_[0]);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    if (!available()) return;
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::stop() {
+    if (!available()) return;
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static double read_event(int fd, double calls) {
+    if (fd < 0) return NOT_AVAILABLE;
+    uint64_t values[3] = {};  // value, time enabled, time running
+    if (::read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+        return NOT_AVAILABLE;
+    }
+    double scaled = static_cast<double>(values[0]) * values[1] / values[2];
+    return scaled / calls;
+}
+
+PerfCounterValues PerfCounters::read(double calls) const {
+    return { read_event(fds_[0], calls), read_event(fds_[1], calls), read_event(fds_[2], calls),
+        read_event(fds_[3], calls), read_event(fds_[4], calls) };
+}
+
+#else
+
+PerfCounters::PerfCounters() : error_("hardware counters need perf_event_open (Linux only)") {
+    for (int& fd : fds_) fd = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop() {}
+
+PerfCounterValues PerfCounters::read(double) const {
+    return { NOT_AVAILABLE, NOT_AVAILABLE, NOT_AVAILABLE, NOT_AVAILABLE, NOT_AVAILABLE };
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+
+// Hardware event totals per benchmarked call; NaN when an event is unavailable
+struct PerfCounterValues {
+    double cycles;
+    double instructions;
+    double l1d_misses;
+    double llc_misses;
+    double branch_misses;
+
+    double ipc() const { return instructions / cycles; }
+};
+
+// Group of hardware counters (cycles, instructions, L1D read misses, LLC misses,
+// branch misses) read through perf_event_open on Linux. When the group cannot be
+// opened (other platforms, virtual machines without a PMU, perf_event_paranoid)
+// available() is false and error() says why; the benchmarks then report timings only.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fds_[0] >= 0; }
+    const std::string& error() const { return error_; }
+
+    // Reset and start counting
+    void start();
+
+    // Stop counting; totals stay readable until the next start()
+    void stop();
+
+    // Totals since the last start() divided by calls, scaled for multiplexing
+    PerfCounterValues read(double calls) const;
+
+private:
+    static const int EVENT_COUNT = 5;
+
+    int fds_[EVENT_COUNT];
+    std::string error_;
+};
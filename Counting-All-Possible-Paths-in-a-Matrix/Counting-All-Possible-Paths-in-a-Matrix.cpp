@@ -1,125 +1,104 @@
+#include <cstdint>
 #include <iostream>
-#include <stack>
-#include <chrono>
+#include <string>
+#include <utility>
 #include <vector>
-#include <array>
 
-const int MAX_SIZE = 100;
-
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
-
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
+#include "Benchmark.h"
+#include "CompileTimeTables.h"
+#include "ModularQueries.h"
+#include "PathCounting.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long max_rolling_cells = runner.int_option("--max-rolling-cells", 100000000);
+    long long max_exact_side = runner.int_option("--max-exact-side", 1000000);
+
+    // The closed form must agree with the compile-time table, which is exact mod 2^64,
+    // and the rolling row, which wraps mod 2^32, with its low 32 bits. The int
+    // tabulation overflows from about 34x34, so it is not a reference here.
+    for (int m = 1; m <= MAX_SIZE; ++m) {
+        for (int n = 1; n <= MAX_SIZE; ++n) {
+            if (countPathsBinomial(m, n).low_word() != PATH_COUNT_TABLE[m - 1][n - 1] ||
+                static_cast<uint32_t>(countPathsRollingRow(m, n)) != static_cast<uint32_t>(PATH_COUNT_TABLE[m - 1][n - 1])) {
+                std::cout << "Mismatch: path counts disagree for " << m << "x" << n << "\n";
+            }
+        }
     }
-    return total_time / iterations;
-}
-
-// Structure to represent a position in the matrix
-struct Position {
-    int i, j;
-    int pathCount;
-};
-
-// Function to count paths using brute force
-int countPathsBruteForce(int m, int n) {
-    std::stack<Position> stk;
-    stk.push({ 0, 0, 1 });
-    int totalPaths = 0;
 
-    while (!stk.empty()) {
-        Position pos = stk.top();
-        stk.pop();
+    std::vector<std::pair<int, int>> sizes = {
+        { 3, 3 }, { 10, 10 }, { 100, 100 }, { 1000, 1000 }, { 10000, 10000 }, { 100000, 100000 }, { 1000000, 1000000 }
+    };
+
+    for (auto [m, n] : sizes) {
+        std::cout << "-----------------------------------\n";
+        std::cout << "Calculating Paths in a " << m << "x" << n << " matrix\n";
+        runner.set_input(std::to_string(m) + "x" + std::to_string(n));
+
+        // The int variants only hold the exact count for small grids and the table stops at MAX_SIZE
+        if (m <= MAX_SIZE && n <= MAX_SIZE) {
+            // Brute force visits every path, so it is limited to small grids
+            if (m + n <= 22) {
+                // Measure execution time for Brute Force Solution
+                runner.run("Brute Force", [&] {
+                    return countPathsBruteForce(m, n);
+                    });
+            }
 
-        int i = pos.i, j = pos.j, pathCount = pos.pathCount;
+            // Signed int overflow is undefined, so the int DP only runs while the
+            // count, the largest value it adds up, fits
+            if (countPathsBinomial(m, n).bit_length() <= 31) {
+                // Measure execution time for Memoization Solution
+                runner.run("Memoization", [&] {
+                    return countPathsMemoizationWrapper(m, n);
+                    });
+
+                // Measure execution time for Tabulation Solution
+                runner.run("Tabulation", [&] {
+                    return countPathsTabulation(m, n);
+                    });
+            }
 
-        // If we reach the bottom-right corner, add to total paths
-        if (i == m - 1 && j == n - 1) {
-            totalPaths += pathCount;
-            continue;
+            // Measure execution time for the table built at compile time. The
+            // indices go through do_not_optimize so the lookup is not hoisted.
+            runner.run("Compile-Time Tabulation", [&] {
+                do_not_optimize(m);
+                do_not_optimize(n);
+                return countPathsCompileTime(m, n);
+                });
+
+            // Measure execution time for the rolling row with the same wrapping int result
+            runner.run("Rolling Row", [&] {
+                return countPathsRollingRow(m, n);
+                });
         }
 
-        // Move right if within bounds
-        if (j + 1 < n) {
-            stk.push({ i, j + 1, pathCount });
+        // Measure execution time for the rolling row mod p, O(m * n) time
+        if (static_cast<long long>(m) * n <= max_rolling_cells) {
+            runner.run("Rolling Row mod p", [&] {
+                return countPathsRollingRowMod(m, n);
+                });
+            if (countPathsRollingRowMod(m, n) != countPathsMod(m, n) ||
+                countPathsRollingRowMod(m, n, DEFAULT_MODULUS, SimdLevel::Scalar) != countPathsMod(m, n)) {
+                std::cout << "Mismatch: rolling row and closed form disagree mod p\n";
+            }
         }
 
-        // Move down if within bounds
-        if (i + 1 < m) {
-            stk.push({ i + 1, j, pathCount });
+        // Measure execution time for the closed form C(m + n - 2, m - 1) mod p
+        runner.run("Closed Form mod p", [&] {
+            return countPathsMod(m, n);
+            });
+        std::cout << "Paths mod " << DEFAULT_MODULUS << " = " << countPathsMod(m, n) << "\n";
+
+        // Measure execution time for the exact closed form
+        if (m <= max_exact_side && n <= max_exact_side) {
+            runner.run("Closed Form (exact)", [&] {
+                return countPathsBinomial(m, n);
+                });
+            std::cout << "Exact path count has " << countPathsBinomial(m, n).bit_length() << " bits\n";
         }
     }
 
-    return totalPaths;
-}
-
-// Function to count paths using dynamic programming with memoization
-int countPathsMemoization(int m, int n, std::vector<std::vector<int>>& dp) {
-    if (m == 1 || n == 1) return 1;  // Base case
-    if (dp[m - 1][n - 1] != -1) return dp[m - 1][n - 1];  // Return memoized result
-    dp[m - 1][n - 1] = countPathsMemoization(m - 1, n, dp) + countPathsMemoization(m, n - 1, dp);  // Memoize result
-    return dp[m - 1][n - 1];
-}
-
-int countPathsMemoizationWrapper(int m, int n) {
-    std::vector<std::vector<int>> dp(m, std::vector<int>(n, -1));
-    return countPathsMemoization(m, n, dp);
-}
-
-// Function to count paths using dynamic programming with tabulation
-int countPathsTabulation(int m, int n) {
-    std::array<std::array<int, MAX_SIZE>, MAX_SIZE> dp = {};
-
-    for (int i = 0; i < m; ++i) {
-        for (int j = 0; j < n; ++j) {
-            if (i == 0 || j == 0) {
-                dp[i][j] = 1;
-            }
-            else {
-                dp[i][j] = dp[i - 1][j] + dp[i][j - 1];
-            }
-        }
-    }
-
-    return dp[m - 1][n - 1];
-}
-
-int main() {
-    int m = 3, n = 3;
-    int iterations = 1000;
-
-    std::cout << "-----------------------------------\n";
-    std::cout << "Calculating Paths in a " << m << "x" << n << " matrix\n";
-
-    // Measure average execution time for Brute Force Solution
-    auto bruteForceTime = average_time([](int m, int n) {
-        countPathsBruteForce(m, n);
-        }, iterations, m, n);
-    std::cout << "Average time for Brute Force: " << bruteForceTime << " ns\n";
-
-    // Measure average execution time for Memoization Solution
-    auto memoizationTime = average_time([](int m, int n) {
-        countPathsMemoizationWrapper(m, n);
-        }, iterations, m, n);
-    std::cout << "Average time for Memoization: " << memoizationTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution
-    auto tabulationTime = average_time([](int m, int n) {
-        countPathsTabulation(m, n);
-        }, iterations, m, n);
-    std::cout << "Average time for Tabulation: " << tabulationTime << " ns\n";
-
     std::cout << "-----------------------------------\n";
 
     return 0;
@@ -0,0 +1,45 @@
+#include <iostream>
+#include <string>
+
+#include "Benchmark.h"
+#include "Fibonacci.h"
+#include "FibonacciBig.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long max_n = runner.int_option("--max-n", 10000000);
+    long long max_linear_n = runner.int_option("--max-linear-n", 100000);
+
+    std::cout << "Fibonacci(100) = " << fibonacci_fast_doubling(100).to_string() << "\n";
+    std::cout << "-----------------------------------\n";
+
+    for (long long n = 10; n <= max_n; n *= 10) {
+        BigUnsigned expected = fibonacci_fast_doubling(n);
+        std::cout << "Calculating Fibonacci(" << n << "), " << expected.bit_length() << " bits\n";
+        runner.set_input(std::to_string(n));
+
+        // The int version is only exact up to Fibonacci(46)
+        if (n <= 40) {
+            runner.run("tabulated Fibonacci (int)", [&] { return fibonacci_tabulation(static_cast<int>(n)); });
+        }
+
+        // Linear tabulation needs O(n^2) bit operations, so it is capped separately
+        if (n <= max_linear_n) {
+            runner.run("linear tabulation", [&] { return big_fibonacci_tabulation(n); });
+            if (big_fibonacci_tabulation(n) != expected) {
+                std::cout << "Mismatch: linear tabulation disagrees with fast doubling\n";
+            }
+        }
+
+        runner.run("fast doubling", [&] { return fibonacci_fast_doubling(n); });
+
+        runner.run("matrix exponentiation", [&] { return fibonacci_matrix(n); });
+        if (fibonacci_matrix(n) != expected) {
+            std::cout << "Mismatch: matrix exponentiation disagrees with fast doubling\n";
+        }
+
+        std::cout << "-----------------------------------\n";
+    }
+
+    return 0;
+}
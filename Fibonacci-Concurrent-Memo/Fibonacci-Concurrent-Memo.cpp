@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "CompileTimeTables.h"
+#include "FibonacciMemo.h"
+
+// Run lookup(thread, begin, end) on thread_count threads, each over its own
+// slice of the indices, and return the combined checksum
+template <typename Lookup>
+uint64_t run_threads(int thread_count, size_t lookups, Lookup lookup) {
+    std::vector<uint64_t> sums(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] { sums[t] = lookup(t * lookups, (t + 1) * lookups); });
+    }
+    uint64_t total = 0;
+    for (int t = 0; t < thread_count; ++t) {
+        threads[t].join();
+        total += sums[t];
+    }
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long max_n = runner.int_option("--max-n", 100000);
+    long long lookups = runner.int_option("--lookups", 1000000);
+    long long max_threads = runner.int_option("--max-threads", std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<unsigned long long> index(0, max_n - 1);
+    std::vector<unsigned long long> indices(lookups * max_threads);
+    for (auto& n : indices) n = index(rng);
+
+    // Warm shared memo, and the same values behind a mutex for comparison
+    FibonacciMemo shared;
+    shared.get(max_n - 1);
+    std::unordered_map<unsigned long long, uint64_t> locked_memo;
+    for (long long n = 0; n < max_n; ++n) locked_memo[n] = shared.get(n);
+    std::mutex memo_mutex;
+
+    for (int n = 0; n <= MAX_FIBONACCI_U64; ++n) {
+        if (shared.get(n) != compile_time_fibonacci_u64(n)) {
+            std::cout << "Mismatch: FibonacciMemo disagrees with the compile-time table at " << n << "\n";
+        }
+    }
+
+    // Threads filling one cold memo at the same time must agree with the warm one
+    FibonacciMemo cold;
+    uint64_t expected = run_threads(static_cast<int>(max_threads), lookups, [&](size_t begin, size_t end) {
+        uint64_t sum = 0;
+        for (size_t i = begin; i < end; ++i) sum += shared.get(indices[i]);
+        return sum;
+        });
+    uint64_t concurrent = run_threads(static_cast<int>(max_threads), lookups, [&](size_t begin, size_t end) {
+        uint64_t sum = 0;
+        for (size_t i = begin; i < end; ++i) sum += cold.get(indices[i]);
+        return sum;
+        });
+    if (concurrent != expected) {
+        std::cout << "Mismatch: concurrently filled memo disagrees with the warm memo\n";
+    }
+
+    // Threads asking cold memos for interleaved n keep extending past each
+    // other, so a thread often finds the prefix already published beyond the
+    // n it is extending to
+    int staggered_threads = std::max(4, static_cast<int>(max_threads));
+    unsigned long long staggered_n = std::min<unsigned long long>(max_n, 4096);
+    for (int round = 0; round < 100; ++round) {
+        FibonacciMemo staggered;
+        std::atomic<int> ready{ 0 };
+        uint64_t wrong = run_threads(staggered_threads, 1, [&](size_t t, size_t) {
+            // Start together so the threads overlap
+            ready.fetch_add(1);
+            while (ready.load() < staggered_threads) std::this_thread::yield();
+            uint64_t count = 0;
+            for (unsigned long long n = t; n < staggered_n; n += staggered_threads) {
+                count += staggered.get(n) != shared.get(n);
+            }
+            return count;
+            });
+        if (wrong) {
+            std::cout << "Mismatch: memo extended by threads with staggered n returned wrong values\n";
+            break;
+        }
+    }
+
+    // Powers of two up to the core count, then the core count itself
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(static_cast<int>(max_threads));
+
+    std::cout << "Fibonacci memo lookups, n < " << max_n << "\n";
+    for (int threads : thread_counts) {
+        runner.set_input(std::to_string(threads) + " threads");
+        double items = static_cast<double>(threads) * lookups;
+
+        runner.run("shared FibonacciMemo", [&] {
+            return run_threads(threads, lookups, [&](size_t begin, size_t end) {
+                uint64_t sum = 0;
+                for (size_t i = begin; i < end; ++i) sum += shared.get(indices[i]);
+                return sum;
+                });
+            }, items);
+
+        runner.run("per-thread FibonacciMemo (cold)", [&] {
+            return run_threads(threads, lookups, [&](size_t begin, size_t end) {
+                FibonacciMemo own;
+                uint64_t sum = 0;
+                for (size_t i = begin; i < end; ++i) sum += own.get(indices[i]);
+                return sum;
+                });
+            }, items);
+
+        runner.run("unordered_map behind a mutex", [&] {
+            return run_threads(threads, lookups, [&](size_t begin, size_t end) {
+                uint64_t sum = 0;
+                for (size_t i = begin; i < end; ++i) {
+                    std::lock_guard<std::mutex> lock(memo_mutex);
+                    sum += locked_memo.find(indices[i])->second;
+                }
+                return sum;
+                });
+            }, items);
+    }
+
+    return 0;
+}
@@ -1,85 +1,28 @@
 #include <iostream>
+#include <string>
 #include <unordered_map>
 #include <vector>
-#include <chrono>
-#include <functional>
 
-// Recursive function to calculate Fibonacci
-int fibonacci(int n) {
-    if (n <= 1) {
-        return n;
-    }
-    else {
-        return fibonacci(n - 1) + fibonacci(n - 2);
-    }
-}
-
-// Recursive function with memoization to calculate Fibonacci
-int fibonacci_memo(int n, std::unordered_map<int, int>& memo) {
-    if (memo.find(n) != memo.end()) {
-        return memo[n];
-    }
-    if (n <= 1) {
-        return n;
-    }
-    memo[n] = fibonacci_memo(n - 1, memo) + fibonacci_memo(n - 2, memo);
-    return memo[n];
-}
-
-// Iterative function with tabulation to calculate Fibonacci
-int fibonacci_tabulation(int n) {
-    if (n <= 1) {
-        return n;
-    }
-    std::vector<int> dp(n + 1, 0);
-    dp[1] = 1;
-    for (int i = 2; i <= n; ++i) {
-        dp[i] = dp[i - 1] + dp[i - 2];
-    }
-    return dp[n];
-}
-
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
-
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
-    }
-    return total_time / iterations;
-}
-
-int main() {
+#include "Benchmark.h"
+#include "Fibonacci.h"
 
-    const int iterations = 1000;
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
     std::vector<int> test_cases = { 10, 20, 30 };
 
     for (int n : test_cases) {
         std::cout << "Calculating Fibonacci(" << n << ")\n";
+        runner.set_input(std::to_string(n));
 
-        // Calculation and average time using the simple recursive function
-        long long avg_time_recursive = average_time(fibonacci, iterations, n);
-        std::cout << "Average time for recursive Fibonacci: " << avg_time_recursive << " ns\n";
+        // Execution time using the simple recursive function
+        runner.run("recursive Fibonacci", [&] { return fibonacci(n); });
 
-        // Calculation and average time using the memoization function
+        // Execution time using the memoization function
         std::unordered_map<int, int> memo;
-        auto fibonacci_memo_wrapper = [&memo](int n) { return fibonacci_memo(n, memo); };
-        long long avg_time_memo = average_time(fibonacci_memo_wrapper, iterations, n);
-        std::cout << "Average time for memoized Fibonacci: " << avg_time_memo << " ns\n";
+        runner.run("memoized Fibonacci", [&] { return fibonacci_memo(n, memo); });
 
-        // Calculation and average time using the tabulation function
-        long long avg_time_tabulation = average_time(fibonacci_tabulation, iterations, n);
-        std::cout << "Average time for tabulated Fibonacci: " << avg_time_tabulation << " ns\n";
+        // Execution time using the tabulation function
+        runner.run("tabulated Fibonacci", [&] { return vector_fibonacci_tabulation(n); });
 
         std::cout << "-----------------------------------\n";
     }
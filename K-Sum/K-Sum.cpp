@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "CpuFeatures.h"
+#include "KSum.h"
+#include "ThreadPool.h"
+
+// Reference answers for the checks: every k-subset of a short sequence, and the
+// reachable sums one byte each
+static bool kSumExists(const std::vector<int>& sequence, size_t first, int k, int64_t targetSum) {
+    if (k == 0) return targetSum == 0;
+    for (size_t i = first; i < sequence.size(); ++i) {
+        if (kSumExists(sequence, i + 1, k - 1, targetSum - sequence[i])) return true;
+    }
+    return false;
+}
+
+static bool subsetSumTable(const std::vector<int>& values, int64_t targetSum) {
+    std::vector<char> reachable(targetSum + 1, 0);
+    reachable[0] = 1;
+    for (int value : values) {
+        for (int64_t sum = targetSum; sum >= value; --sum) reachable[sum] |= reachable[sum - value];
+    }
+    return reachable[targetSum];
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long max_work = runner.int_option("--max-work", 100000000);
+    long long max_subset_n = runner.int_option("--max-subset-n", 10000);
+
+    std::mt19937 rng(42);
+
+    // Randomised checks against the references, with and without a pool
+    ThreadPool pool;
+    for (int trial = 0; trial < 200; ++trial) {
+        std::uniform_int_distribution<int> value(-50, 50);
+        std::vector<int> sequence(5 + trial % 16);
+        for (auto& v : sequence) v = value(rng);
+        int k = 1 + trial % 5;
+        int64_t targetSum = value(rng) * (k / 2 + 1);
+        auto found = IndicesKSum(sequence, k, targetSum, trial % 2 ? &pool : nullptr);
+        int64_t sum = 0;
+        if (found) {
+            for (size_t j = 0; j < found->size(); ++j) sum += sequence[(*found)[j]];
+        }
+        bool distinct = !found || (found->size() == size_t(k) && std::adjacent_find(found->begin(), found->end()) == found->end());
+        if (found.has_value() != kSumExists(sequence, 0, k, targetSum) || !distinct || (found && sum != targetSum)) {
+            std::cout << "Mismatch: IndicesKSum, k = " << k << ", target " << targetSum << "\n";
+            break;
+        }
+
+        std::uniform_int_distribution<int> weight(0, 300);
+        std::vector<int> values(1 + trial % 40);
+        for (auto& v : values) v = weight(rng);
+        int64_t subsetTarget = std::uniform_int_distribution<int64_t>(0, 40 * 150)(rng);
+        bool expected = subsetSumTable(values, subsetTarget);
+        if (subsetSumBitset(values, subsetTarget, nullptr, SimdLevel::Scalar) != expected ||
+            subsetSumBitset(values, subsetTarget, nullptr) != expected) {
+            std::cout << "Mismatch: subsetSumBitset, target " << subsetTarget << "\n";
+            break;
+        }
+    }
+
+    // The pool path only splits bitsets of 2 * SUBSET_SUM_PARALLEL_WORDS words or
+    // more, so its check needs a pool of several threads and sums past that. A
+    // few large values keep the reachable sums sparse, so a word the update gets
+    // wrong is not hidden by other values reaching the same sums.
+    {
+        ThreadPool checkPool(4);
+        int64_t minValue = int64_t(64 * SUBSET_SUM_PARALLEL_WORDS / 2);
+        std::uniform_int_distribution<int64_t> weight(minValue, 2 * minValue - 1);
+        std::vector<int> values(12);
+        for (auto& v : values) v = static_cast<int>(weight(rng));
+        for (int trial = 0; trial < 32; ++trial) {
+            // Any 4 or more values add up to a sum on the pool path
+            std::shuffle(values.begin(), values.end(), rng);
+            int64_t reachable = std::accumulate(values.begin(), values.begin() + 6, int64_t(0));
+            bool mismatch = false;
+            for (int64_t subsetTarget : { reachable, reachable + 1 }) {
+                bool expected = subsetSumBitset(values, subsetTarget, nullptr, SimdLevel::Scalar);
+                mismatch |= subsetSumBitset(values, subsetTarget, &checkPool, SimdLevel::Scalar) != expected ||
+                    subsetSumBitset(values, subsetTarget, &checkPool) != expected;
+            }
+            if (mismatch) {
+                std::cout << "Mismatch: subsetSumBitset with a pool, target " << reachable << "\n";
+                break;
+            }
+        }
+    }
+
+    // k-Sum: even values and an odd target, so no k of them add up to it and
+    // every branch the bounds leave open is searched
+    std::vector<int> ks = { 2, 3, 4 };
+    std::vector<long long> sizes = { 100, 1000, 10000 };
+    std::vector<std::vector<double>> medians(ks.size(), std::vector<double>(sizes.size(), 0));
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        long long n = sizes[s];
+        std::uniform_int_distribution<int> value(-(1 << 29), (1 << 29) - 1);
+        std::vector<int> sequence(n);
+        for (auto& v : sequence) v = 2 * value(rng);
+
+        std::cout << "-----------------------------------\n";
+        std::cout << "k-Sum over " << n << " even values, odd target\n";
+        for (size_t j = 0; j < ks.size(); ++j) {
+            int k = ks[j];
+            double work = 1;
+            for (int level = 1; level < k; ++level) work *= static_cast<double>(n);
+            if (work > max_work) continue;
+            runner.set_input(std::to_string(n) + ", k = " + std::to_string(k));
+            medians[j][s] = runner.run("IndicesKSum", [&] {
+                return IndicesKSum(sequence, k, 1);
+                }, static_cast<double>(n)).median;
+            if (k >= 3 && pool.size() > 1) {
+                runner.run("IndicesKSum, pool", [&] {
+                    return IndicesKSum(sequence, k, 1, &pool);
+                    }, static_cast<double>(n));
+            }
+        }
+    }
+
+    std::cout << "-----------------------------------\n";
+    std::cout << "IndicesKSum median, ms (- over --max-work)\n";
+    std::cout << std::setw(8) << "n";
+    for (int k : ks) std::cout << std::setw(12) << ("k = " + std::to_string(k));
+    std::cout << "\n";
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        std::cout << std::setw(8) << sizes[s];
+        for (size_t j = 0; j < ks.size(); ++j) {
+            if (medians[j][s] > 0) std::cout << std::setw(12) << std::fixed << std::setprecision(3) << medians[j][s] / 1e6;
+            else std::cout << std::setw(12) << "-";
+        }
+        std::cout << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+
+    // Subset-sum: even weights and an odd target near half their total, which is
+    // never reached, so every value is applied
+    for (long long n = 100; n <= max_subset_n; n *= 10) {
+        std::uniform_int_distribution<int> weight(1, 499);
+        std::vector<int> values(n);
+        for (auto& v : values) v = 2 * weight(rng);
+        int64_t targetSum = std::accumulate(values.begin(), values.end(), int64_t(0)) / 2 | 1;
+
+        std::cout << "-----------------------------------\n";
+        std::cout << "Subset-sum of " << n << " even weights below 1000, target " << targetSum << "\n";
+        runner.set_input(std::to_string(n));
+        double items = static_cast<double>(n);
+        for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2 }) {
+            if (supportedSimdLevel(level) != level) continue;
+            runner.run(std::string("subsetSumBitset ") + simdLevelName(level), [&] {
+                return subsetSumBitset(values, targetSum, nullptr, level);
+                }, items);
+        }
+        if (pool.size() > 1) {
+            runner.run("subsetSumBitset, pool", [&] {
+                return subsetSumBitset(values, targetSum, &pool);
+                }, items);
+        }
+        if (n <= 1000) {
+            runner.run("byte table", [&] {
+                return subsetSumTable(values, targetSum);
+                }, items);
+        }
+    }
+
+    std::cout << "-----------------------------------\n";
+
+    return 0;
+}
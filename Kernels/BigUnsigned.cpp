@@ -0,0 +1,210 @@
+#include "BigUnsigned.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// 64x64 -> 128-bit product split into high and low words
+static inline uint64_t mul_wide(uint64_t a, uint64_t b, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    high = static_cast<uint64_t>(product >> 64);
+    return static_cast<uint64_t>(product);
+#else
+    return _umul128(a, b, &high);
+#endif
+}
+
+// r[0..rn) += a[0..an), returns the carry out of r[rn - 1]
+static uint64_t add_into(uint64_t* r, size_t rn, const uint64_t* a, size_t an) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < an; ++i) {
+        uint64_t sum = r[i] + carry;
+        carry = sum < carry;
+        sum += a[i];
+        carry += sum < a[i];
+        r[i] = sum;
+    }
+    for (; carry && i < rn; ++i) {
+        carry = ++r[i] == 0;
+    }
+    return carry;
+}
+
+// r[0..rn) -= a[0..an), the caller guarantees r >= a
+static void sub_into(uint64_t* r, size_t rn, const uint64_t* a, size_t an) {
+    uint64_t borrow = 0;
+    size_t i = 0;
+    for (; i < an; ++i) {
+        uint64_t value = r[i];
+        uint64_t difference = value - a[i] - borrow;
+        borrow = (value < a[i]) || (value - a[i] < borrow);
+        r[i] = difference;
+    }
+    for (; borrow && i < rn; ++i) {
+        borrow = r[i]-- == 0;
+    }
+}
+
+// out[0..na + nb) = a * b by the schoolbook method
+static void mul_schoolbook(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* out) {
+    std::fill(out, out + na + nb, 0);
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < nb; ++j) {
+            uint64_t high;
+            uint64_t low = mul_wide(a[i], b[j], high);
+            low += carry;
+            high += low < carry;
+            low += out[i + j];
+            high += low < out[i + j];
+            out[i + j] = low;
+            carry = high;
+        }
+        out[i + nb] = carry;
+    }
+}
+
+static void mul_limbs(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* out);
+
+// out[0..2n) = a * b for two n-limb operands
+static void mul_karatsuba(const uint64_t* a, const uint64_t* b, size_t n, uint64_t* out) {
+    if (n < BigUnsigned::KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, n, b, n, out);
+        return;
+    }
+    size_t low = n / 2;
+    size_t high = n - low;
+
+    // z0 = a0 * b0 and z2 = a1 * b1 go straight into the result
+    mul_karatsuba(a, b, low, out);
+    mul_karatsuba(a + low, b + low, high, out + 2 * low);
+
+    // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+    std::vector<uint64_t> sum_a(a + low, a + n), sum_b(b + low, b + n);
+    sum_a.push_back(add_into(sum_a.data(), high, a, low));
+    sum_b.push_back(add_into(sum_b.data(), high, b, low));
+    std::vector<uint64_t> middle(2 * (high + 1));
+    mul_karatsuba(sum_a.data(), sum_b.data(), high + 1, middle.data());
+    sub_into(middle.data(), middle.size(), out, 2 * low);
+    sub_into(middle.data(), middle.size(), out + 2 * low, 2 * high);
+
+    size_t used = middle.size();
+    while (used > 0 && middle[used - 1] == 0) --used;
+    add_into(out + low, 2 * n - low, middle.data(), used);
+}
+
+// out[0..na + nb) = a * b for operands of any size
+static void mul_limbs(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < BigUnsigned::KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, na, b, nb, out);
+        return;
+    }
+    if (na == nb) {
+        mul_karatsuba(a, b, na, out);
+        return;
+    }
+    // Unbalanced: multiply b by nb-limb slices of a and accumulate
+    std::fill(out, out + na + nb, 0);
+    std::vector<uint64_t> partial(2 * nb);
+    for (size_t offset = 0; offset < na; offset += nb) {
+        size_t length = std::min(nb, na - offset);
+        mul_limbs(a + offset, length, b, nb, partial.data());
+        add_into(out + offset, na + nb - offset, partial.data(), length + nb);
+    }
+}
+
+BigUnsigned::BigUnsigned(uint64_t value) {
+    if (value) limbs_.push_back(value);
+}
+
+void BigUnsigned::trim() {
+    while (!limbs_.empty() && limbs_.back() == 0) {
+        limbs_.pop_back();
+    }
+}
+
+size_t BigUnsigned::bit_length() const {
+    if (limbs_.empty()) return 0;
+    uint64_t top = limbs_.back();
+    size_t bits = 0;
+    while (top) {
+        ++bits;
+        top >>= 1;
+    }
+    return 64 * (limbs_.size() - 1) + bits;
+}
+
+BigUnsigned& BigUnsigned::operator+=(const BigUnsigned& other) {
+    if (limbs_.size() < other.limbs_.size()) {
+        limbs_.resize(other.limbs_.size(), 0);
+    }
+    if (add_into(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size())) {
+        limbs_.push_back(1);
+    }
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator-=(const BigUnsigned& other) {
+    sub_into(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+    trim();
+    return *this;
+}
+
+BigUnsigned& BigUnsigned::operator<<=(unsigned bits) {
+    if (limbs_.empty()) return *this;
+    unsigned words = bits / 64, shift = bits % 64;
+    if (shift) {
+        limbs_.push_back(0);
+        for (size_t i = limbs_.size() - 1; i > 0; --i) {
+            limbs_[i] = (limbs_[i] << shift) | (limbs_[i - 1] >> (64 - shift));
+        }
+        limbs_[0] <<= shift;
+    }
+    limbs_.insert(limbs_.begin(), words, 0);
+    trim();
+    return *this;
+}
+
+BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b) {
+    BigUnsigned product;
+    if (a.is_zero() || b.is_zero()) return product;
+    product.limbs_.resize(a.limbs_.size() + b.limbs_.size());
+    mul_limbs(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(), product.limbs_.data());
+    product.trim();
+    return product;
+}
+
+std::string BigUnsigned::to_string() const {
+    if (limbs_.empty()) return "0";
+    const uint64_t chunk = 10000000000000000000ull;  // 10^19, the largest power of ten in a limb
+    std::vector<uint64_t> value = limbs_;
+    std::vector<uint64_t> chunks;
+    while (!value.empty()) {
+        uint64_t remainder = 0;
+        for (size_t i = value.size(); i-- > 0;) {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 current = (static_cast<unsigned __int128>(remainder) << 64) | value[i];
+            value[i] = static_cast<uint64_t>(current / chunk);
+            remainder = static_cast<uint64_t>(current % chunk);
+#else
+            value[i] = _udiv128(remainder, value[i], chunk, &remainder);
+#endif
+        }
+        while (!value.empty() && value.back() == 0) value.pop_back();
+        chunks.push_back(remainder);
+    }
+    std::string digits = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string part = std::to_string(chunks[i]);
+        digits += std::string(19 - part.size(), '0') + part;
+    }
+    return digits;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision non-negative integer stored as little-endian 64-bit limbs.
+// Multiplication switches from schoolbook to Karatsuba above KARATSUBA_THRESHOLD limbs.
+class BigUnsigned {
+public:
+    static const size_t KARATSUBA_THRESHOLD = 32;
+
+    BigUnsigned() = default;
+    BigUnsigned(uint64_t value);
+
+    bool is_zero() const { return limbs_.empty(); }
+    size_t limb_count() const { return limbs_.size(); }
+    size_t bit_length() const;
+    const std::vector<uint64_t>& limbs() const { return limbs_; }
+
+    // Value modulo 2^64
+    uint64_t low_word() const { return limbs_.empty() ? 0 : limbs_[0]; }
+
+    BigUnsigned& operator+=(const BigUnsigned& other);
+    BigUnsigned& operator-=(const BigUnsigned& other);  // requires *this >= other
+    BigUnsigned& operator<<=(unsigned bits);
+
+    friend BigUnsigned operator+(BigUnsigned a, const BigUnsigned& b) { return a += b; }
+    friend BigUnsigned operator-(BigUnsigned a, const BigUnsigned& b) { return a -= b; }
+    friend BigUnsigned operator<<(BigUnsigned a, unsigned bits) { return a <<= bits; }
+    friend BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b);
+
+    friend bool operator==(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ != b.limbs_; }
+
+    // Decimal representation; quadratic, meant for printing and checking results
+    std::string to_string() const;
+
+private:
+    void trim();
+
+    std::vector<uint64_t> limbs_;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "PathCounting.h"
+
+// Largest n whose Fibonacci number fits in uint64_t
+const int MAX_FIBONACCI_U64 = 93;
+
+// F(0..93), built by the compiler
+consteval std::array<uint64_t, MAX_FIBONACCI_U64 + 1> make_fibonacci_table() {
+    std::array<uint64_t, MAX_FIBONACCI_U64 + 1> table{};
+    table[1] = 1;
+    for (int i = 2; i <= MAX_FIBONACCI_U64; ++i) {
+        table[i] = table[i - 1] + table[i - 2];
+    }
+    return table;
+}
+
+inline constexpr auto FIBONACCI_TABLE = make_fibonacci_table();
+
+// Path counts for every grid up to MAX_SIZE x MAX_SIZE, built by the compiler:
+// entry [i][j] is C(i + j, i), the paths in an (i + 1) x (j + 1) grid. Values
+// are exact while i + j <= 67 and reduced mod 2^64 beyond that.
+consteval std::array<std::array<uint64_t, MAX_SIZE>, MAX_SIZE> make_path_count_table() {
+    std::array<std::array<uint64_t, MAX_SIZE>, MAX_SIZE> table{};
+    for (int i = 0; i < MAX_SIZE; ++i) {
+        for (int j = 0; j < MAX_SIZE; ++j) {
+            table[i][j] = (i == 0 || j == 0) ? 1 : table[i - 1][j] + table[i][j - 1];
+        }
+    }
+    return table;
+}
+
+inline constexpr auto PATH_COUNT_TABLE = make_path_count_table();
+
+// Fibonacci from the compile-time table, same signature as fibonacci_tabulation
+inline int compile_time_fibonacci(int n) {
+    return static_cast<int>(FIBONACCI_TABLE[n]);
+}
+
+// Exact Fibonacci for 0 <= n <= 93
+inline uint64_t compile_time_fibonacci_u64(int n) {
+    return FIBONACCI_TABLE[n];
+}
+
+// Path count from the compile-time table, same signature as countPathsTabulation.
+// The int result wraps exactly like the runtime tabulation does.
+inline int countPathsCompileTime(int m, int n) {
+    return static_cast<int>(PATH_COUNT_TABLE[m - 1][n - 1]);
+}
+
+// C(n, k) for n - k and k below MAX_SIZE, exact while n <= 67
+inline uint64_t binomialCompileTime(int n, int k) {
+    return PATH_COUNT_TABLE[k][n - k];
+}
+
+// Spot checks, evaluated at compile time
+static_assert(FIBONACCI_TABLE[40] == 102334155);
+static_assert(FIBONACCI_TABLE[93] == 12200160415121876738ull);
+static_assert(PATH_COUNT_TABLE[2][2] == 6);
+static_assert(PATH_COUNT_TABLE[33][34] == 14226520737620288370ull);
@@ -0,0 +1,51 @@
+#include "CpuFeatures.h"
+
+#if defined(DP_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+// Ask cpuid and, for the wide registers, XCR0 whether the OS saves them
+static SimdLevel detectSimdLevel() {
+#if defined(DP_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return SimdLevel::Scalar;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] >> 27) & 1;
+    bool avx = (info[2] >> 28) & 1;
+    if (!osxsave || !avx) return SimdLevel::Scalar;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] >> 5) & 1;
+    bool avx512 = ((info[1] >> 16) & 1) && ((info[1] >> 30) & 1);  // F and BW
+    if (avx512 && (xcr0 & 0xE6) == 0xE6) return SimdLevel::Avx512;
+    if (avx2 && (xcr0 & 0x6) == 0x6) return SimdLevel::Avx2;
+    return SimdLevel::Scalar;
+#elif defined(DP_X86)
+    // libgcc and compiler-rt check XCR0 as part of these queries
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+    return SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel bestSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel supportedSimdLevel(SimdLevel requested) {
+    return static_cast<int>(requested) <= static_cast<int>(bestSimdLevel()) ? requested : bestSimdLevel();
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Avx512: return "AVX-512";
+    case SimdLevel::Avx2: return "AVX2";
+    default: return "scalar";
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// x86 SIMD kernels are compiled with per-function target attributes and chosen
+// at run time, so one binary uses AVX-512 or AVX2 where available and still runs
+// on CPUs without them. MSVC accepts the intrinsics without attributes.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DP_X86 1
+#if defined(__GNUC__) || defined(__clang__)
+#define DP_TARGET_AVX2 __attribute__((target("avx2")))
+#define DP_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define DP_TARGET_AVX2
+#define DP_TARGET_AVX512
+#endif
+#endif
+
+// Widest instruction set a kernel may use
+enum class SimdLevel {
+    Scalar,
+    Avx2,
+    Avx512,  // AVX-512 F and BW
+};
+
+// Widest level supported by both the CPU and the operating system, detected once
+SimdLevel bestSimdLevel();
+
+// The requested level, lowered to what this machine supports
+SimdLevel supportedSimdLevel(SimdLevel requested);
+
+const char* simdLevelName(SimdLevel level);
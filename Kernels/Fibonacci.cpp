@@ -0,0 +1,78 @@
+#include "Fibonacci.h"
+
+#include <array>
+#include <vector>
+
+// Recursive function to calculate Fibonacci
+int fibonacci(int n) {
+    if (n <= 1) {
+        return n;
+    }
+    else {
+        return fibonacci(n - 1) + fibonacci(n - 2);
+    }
+}
+
+// Recursive function with memoization to calculate Fibonacci
+int fibonacci_memo(int n, std::unordered_map<int, int>& memo) {
+    if (memo.find(n) != memo.end()) {
+        return memo[n];
+    }
+    if (n <= 1) {
+        return n;
+    }
+    memo[n] = fibonacci_memo(n - 1, memo) + fibonacci_memo(n - 2, memo);
+    return memo[n];
+}
+
+// Iterative function with tabulation to calculate Fibonacci using arrays
+int fibonacci_tabulation(int n) {
+    if (n <= 1) {
+        return n;
+    }
+    std::array<int, 41> dp = {};  // array to support up to Fibonacci(40)
+    dp[1] = 1;
+    for (int i = 2; i <= n; ++i) {
+        dp[i] = dp[i - 1] + dp[i - 2];
+    }
+    return dp[n];
+}
+
+// Iterative function with tabulation to calculate Fibonacci using vectors
+int vector_fibonacci_tabulation(int n) {
+    if (n <= 1) {
+        return n;
+    }
+    std::vector<int> dp(n + 1, 0);
+    dp[1] = 1;
+    for (int i = 2; i <= n; ++i) {
+        dp[i] = dp[i - 1] + dp[i - 2];
+    }
+    return dp[n];
+}
+
+bool found[MAXN] = { false };
+int memo[MAXN] = { 0 };
+
+// New function with memoization using arrays
+int cArray_fibonacci_memo(int n) {
+    if (found[n]) return memo[n];
+    if (n == 0) return 0;
+    if (n == 1) return 1;
+
+    found[n] = true;
+    return memo[n] = cArray_fibonacci_memo(n - 1) + cArray_fibonacci_memo(n - 2);
+}
+
+// New function with tabulation using arrays
+int cArray_fibonacci_tabulation(int n) {
+    if (n <= 1) {
+        return n;
+    }
+    int dp[MAXN] = { 0 };  // array to support up to MAXN
+    dp[1] = 1;
+    for (int i = 2; i <= n; ++i) {
+        dp[i] = dp[i - 1] + dp[i - 2];
+    }
+    return dp[n];
+}
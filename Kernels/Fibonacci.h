@@ -0,0 +1,24 @@
+#pragma once
+
+#include <unordered_map>
+
+// Recursive function to calculate Fibonacci
+int fibonacci(int n);
+
+// Recursive function with memoization to calculate Fibonacci
+int fibonacci_memo(int n, std::unordered_map<int, int>& memo);
+
+// Iterative function with tabulation to calculate Fibonacci using arrays
+int fibonacci_tabulation(int n);
+
+// Iterative function with tabulation to calculate Fibonacci using vectors
+int vector_fibonacci_tabulation(int n);
+
+// structs for C style functions
+const int MAXN = 100;
+
+// New function with memoization using arrays
+int cArray_fibonacci_memo(int n);
+
+// New function with tabulation using arrays
+int cArray_fibonacci_tabulation(int n);
@@ -0,0 +1,72 @@
+#include "FibonacciBig.h"
+
+#include <utility>
+
+// Exact F(n) by repeated addition of big integers, O(n^2) bit operations
+BigUnsigned big_fibonacci_tabulation(unsigned long long n) {
+    BigUnsigned previous = 0, current = 1;
+    if (n == 0) return previous;
+    for (unsigned long long i = 2; i <= n; ++i) {
+        previous += current;
+        std::swap(previous, current);
+    }
+    return current;
+}
+
+// Index of the highest set bit; n must be non-zero
+static int top_bit(unsigned long long n) {
+    int bit = 63;
+    while (!(n >> bit)) --bit;
+    return bit;
+}
+
+// Exact F(n) by fast doubling, walking the bits of n from the top. The
+// leading bits run on uint64_t until F(k+1) would no longer fit (k > 46).
+BigUnsigned fibonacci_fast_doubling(unsigned long long n) {
+    if (n == 0) return 0;
+    int bit = top_bit(n);
+    unsigned long long k = 0;
+    uint64_t small_a = 0, small_b = 1;  // F(k), F(k+1)
+    for (; bit >= 0 && (2 * k + 2) <= 93; --bit) {
+        uint64_t c = small_a * (2 * small_b - small_a);
+        uint64_t d = small_a * small_a + small_b * small_b;
+        k = 2 * k + ((n >> bit) & 1);
+        small_a = (n >> bit) & 1 ? d : c;
+        small_b = (n >> bit) & 1 ? c + d : d;
+    }
+
+    BigUnsigned a = small_a, b = small_b;  // F(k), F(k+1) with k the bits of n seen so far
+    for (; bit >= 0; --bit) {
+        BigUnsigned c = a * ((b << 1) - a);  // F(2k)
+        BigUnsigned d = a * a + b * b;       // F(2k+1)
+        if ((n >> bit) & 1) {
+            a = std::move(d);
+            b = c + a;                       // F(2k+2)
+        }
+        else {
+            a = std::move(c);
+            b = std::move(d);
+        }
+    }
+    return a;
+}
+
+// Exact F(n) from Q^n = [[F(n+1), F(n)], [F(n), F(n-1)]]. Powers of Q are
+// symmetric, so squaring needs three products and multiplying by Q only additions.
+BigUnsigned fibonacci_matrix(unsigned long long n) {
+    if (n == 0) return 0;
+    BigUnsigned top = 1, side = 1, bottom = 0;  // Q^1
+    for (int bit = top_bit(n) - 1; bit >= 0; --bit) {
+        BigUnsigned side_squared = side * side;
+        BigUnsigned new_side = side * (top + bottom);
+        top = top * top + side_squared;
+        bottom = bottom * bottom + side_squared;
+        side = std::move(new_side);
+        if ((n >> bit) & 1) {
+            bottom = side;
+            side = top;
+            top += bottom;
+        }
+    }
+    return side;
+}
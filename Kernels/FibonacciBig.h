@@ -0,0 +1,13 @@
+#pragma once
+
+#include "BigUnsigned.h"
+
+// Exact F(n) by repeated addition of big integers, O(n^2) bit operations
+BigUnsigned big_fibonacci_tabulation(unsigned long long n);
+
+// Exact F(n) by fast doubling:
+// F(2k) = F(k) * (2F(k+1) - F(k)),  F(2k+1) = F(k)^2 + F(k+1)^2
+BigUnsigned fibonacci_fast_doubling(unsigned long long n);
+
+// Exact F(n) by squaring the Fibonacci Q-matrix [[1, 1], [1, 0]]
+BigUnsigned fibonacci_matrix(unsigned long long n);
@@ -0,0 +1,57 @@
+#include "FibonacciMemo.h"
+
+#include <bit>
+
+FibonacciMemo::~FibonacciMemo() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+// Slot of F(n), allocating its chunk on first use. Racing allocations are
+// resolved by compare-exchange and the loser frees its chunk.
+std::atomic<uint64_t>& FibonacciMemo::slot(unsigned long long n) {
+    unsigned long long shifted = n + (1ull << FIRST_CHUNK_BITS);
+    int chunk = std::bit_width(shifted) - 1 - FIRST_CHUNK_BITS;
+    unsigned long long offset = shifted - (1ull << (chunk + FIRST_CHUNK_BITS));
+
+    std::atomic<uint64_t>* slots = chunks_[chunk].load(std::memory_order_acquire);
+    if (!slots) {
+        auto* fresh = new std::atomic<uint64_t>[1ull << (chunk + FIRST_CHUNK_BITS)]();
+        if (chunks_[chunk].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+            slots = fresh;
+        }
+        else {
+            delete[] fresh;
+        }
+    }
+    return slots[offset];
+}
+
+// Fill the slots from the published prefix up to n, then publish them
+uint64_t FibonacciMemo::extend(unsigned long long n) {
+    unsigned long long start = filled_.load(std::memory_order_acquire);
+    if (start > n) {
+        // Another thread published past n since get() checked the prefix
+        return slot(n).load(std::memory_order_acquire);
+    }
+    uint64_t previous = 0, current = 0;  // F(i - 2), F(i - 1)
+    if (start >= 2) {
+        previous = slot(start - 2).load(std::memory_order_relaxed);
+        current = slot(start - 1).load(std::memory_order_relaxed);
+    }
+
+    for (unsigned long long i = start; i <= n; ++i) {
+        uint64_t value = i < 2 ? i : previous + current;
+        slot(i).store(value, std::memory_order_relaxed);
+        previous = current;
+        current = value;
+    }
+
+    // Raise the prefix unless another thread already published further
+    unsigned long long published = start;
+    while (published <= n &&
+        !filled_.compare_exchange_weak(published, n + 1, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return current;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Thread-safe Fibonacci memo that grows on demand. Values are F(n) mod 2^64,
+// exact up to F(93). Slots live in chunks of doubling size that are never
+// moved, so published values stay valid while the memo grows. A prefix
+// counter is released after its slots are written: readers that see
+// n < prefix read the slot without locking and never see a torn value.
+// Several threads may extend the memo at once and write identical values.
+class FibonacciMemo {
+public:
+    FibonacciMemo() = default;
+    ~FibonacciMemo();
+
+    FibonacciMemo(const FibonacciMemo&) = delete;
+    FibonacciMemo& operator=(const FibonacciMemo&) = delete;
+
+    // F(n) mod 2^64, computing and publishing the missing slots up to n
+    uint64_t get(unsigned long long n) {
+        if (n < filled_.load(std::memory_order_acquire)) {
+            return slot(n).load(std::memory_order_relaxed);
+        }
+        return extend(n);
+    }
+
+    // Number of published slots, F(0) .. F(size() - 1)
+    unsigned long long size() const { return filled_.load(std::memory_order_acquire); }
+
+private:
+    static const int FIRST_CHUNK_BITS = 7;  // chunk c holds 128 << c slots
+    static const int MAX_CHUNKS = 64 - FIRST_CHUNK_BITS;
+
+    std::atomic<uint64_t>& slot(unsigned long long n);
+    uint64_t extend(unsigned long long n);
+
+    std::array<std::atomic<std::atomic<uint64_t>*>, MAX_CHUNKS> chunks_{};
+    std::atomic<unsigned long long> filled_{ 0 };
+};
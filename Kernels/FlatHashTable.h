@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DP_FLAT_TABLE_SSE2 1
+#endif
+
+// Open-addressing hash table from integer keys to values, laid out as separate
+// key and value arrays in groups of 16 slots. Each slot has a control byte with
+// 7 bits of the key's hash, so one 16-byte compare finds the candidate slots of
+// a group, in the style of Swiss tables; probing moves on group by group. Keys
+// are never erased. clear() is O(1): every group carries the generation it was
+// last written in and groups from older generations count as empty. With
+// Value = void the table is a set (see FlatHashSet) and stores no values.
+template <typename Key, typename Value>
+class FlatHashTable {
+public:
+    static const size_t GROUP = 16;
+    static constexpr bool IS_SET = std::is_void_v<Value>;
+
+    explicit FlatHashTable(size_t count = 0) { reserve(count); }
+
+    size_t size() const { return size_; }
+
+    // Room for count keys without growing; keeps the current keys
+    void reserve(size_t count) {
+        // At most 7/8 of the slots are used, so a probe always ends at a free slot
+        size_t groups = std::bit_ceil(std::max<size_t>(2, (count * 8 / 7 + GROUP - 1) / GROUP));
+        if (groups > generations_.size()) rehash(groups);
+    }
+
+    void clear() {
+        size_ = 0;
+        if (++generation_ == 0) {
+            std::fill(generations_.begin(), generations_.end(), 0);
+            generation_ = 1;
+        }
+    }
+
+    bool contains(Key key) const { return findSlot(key) != NOT_FOUND; }
+
+    // Value stored for key, or nullptr
+    const Value* find(Key key) const requires (!IS_SET) {
+        size_t slot = findSlot(key);
+        return slot == NOT_FOUND ? nullptr : &values_[slot];
+    }
+
+    // Store value for key, replacing an earlier one
+    template <typename V>
+    void insert_or_assign(Key key, V&& value) requires (!IS_SET) {
+        values_[insertSlot(key)] = std::forward<V>(value);
+    }
+
+    // Add key to a set
+    void insert(Key key) requires IS_SET { insertSlot(key); }
+
+private:
+    static const uint8_t EMPTY = 0x80;
+    static const size_t NOT_FOUND = ~size_t(0);
+
+    size_t findSlot(Key key) const {
+        uint64_t hash = hashOf(key);
+        uint8_t tag = static_cast<uint8_t>(hash >> (shift_ - 7) & 0x7F);
+        for (size_t group = hash >> shift_;; group = (group + 1) & (generations_.size() - 1)) {
+            if (generations_[group] != generation_) return NOT_FOUND;
+            const uint8_t* control = &control_[group * GROUP];
+            for (uint32_t match = matchByte(control, tag); match; match &= match - 1) {
+                size_t slot = group * GROUP + std::countr_zero(match);
+                if (keys_[slot] == key) return slot;
+            }
+            if (matchByte(control, EMPTY)) return NOT_FOUND;
+        }
+    }
+
+    // Slot holding key, claiming a free one if it is new
+    size_t insertSlot(Key key) {
+        if ((size_ + 1) * 8 > generations_.size() * GROUP * 7) rehash(generations_.size() * 2);
+        uint64_t hash = hashOf(key);
+        uint8_t tag = static_cast<uint8_t>(hash >> (shift_ - 7) & 0x7F);
+        for (size_t group = hash >> shift_;; group = (group + 1) & (generations_.size() - 1)) {
+            uint8_t* control = &control_[group * GROUP];
+            if (generations_[group] != generation_) {
+                // First write to this group in the current generation
+                std::memset(control, EMPTY, GROUP);
+                generations_[group] = generation_;
+            }
+            for (uint32_t match = matchByte(control, tag); match; match &= match - 1) {
+                size_t slot = group * GROUP + std::countr_zero(match);
+                if (keys_[slot] == key) return slot;
+            }
+            if (uint32_t empty = matchByte(control, EMPTY)) {
+                size_t position = std::countr_zero(empty);
+                control[position] = tag;
+                keys_[group * GROUP + position] = key;
+                ++size_;
+                return group * GROUP + position;
+            }
+        }
+    }
+
+    // Fibonacci hashing: the top bits pick the group and the 7 bits below them
+    // are the tag; the low bits of the product are too weak for either
+    static uint64_t hashOf(Key key) { return static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL; }
+
+    // Bit k is set when control[k] == byte
+    static uint32_t matchByte(const uint8_t* control, uint8_t byte) {
+#if defined(DP_FLAT_TABLE_SSE2)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(byte)))));
+#else
+        uint32_t match = 0;
+        for (size_t k = 0; k < GROUP; ++k) match |= uint32_t(control[k] == byte) << k;
+        return match;
+#endif
+    }
+
+    void rehash(size_t groups) {
+        std::vector<Key> keys(groups * GROUP);
+        std::vector<Stored> values(IS_SET ? 0 : groups * GROUP);
+        std::vector<uint8_t> control(groups * GROUP);
+        std::vector<uint32_t> generations(groups, 0);
+        keys.swap(keys_);
+        values.swap(values_);
+        control.swap(control_);
+        generations.swap(generations_);
+        uint32_t old_generation = generation_;
+        generation_ = 1;
+        shift_ = 64 - std::countr_zero(groups);
+        size_ = 0;
+        for (size_t group = 0; group < generations.size(); ++group) {
+            if (generations[group] != old_generation) continue;
+            for (size_t k = 0; k < GROUP; ++k) {
+                size_t slot = group * GROUP + k;
+                if (control[slot] == EMPTY) continue;
+                size_t moved = insertSlot(keys[slot]);
+                if constexpr (!IS_SET) values_[moved] = std::move(values[slot]);
+            }
+        }
+    }
+
+    // Sets keep values_ empty; the placeholder type only makes it declarable
+    using Stored = std::conditional_t<IS_SET, char, Value>;
+
+    std::vector<Key> keys_;
+    std::vector<Stored> values_;
+    std::vector<uint8_t> control_;
+    std::vector<uint32_t> generations_;  // generation each group was last written in
+    uint32_t generation_ = 1;
+    unsigned shift_ = 63;  // 64 - log2(number of groups); there are at least 2
+    size_t size_ = 0;
+};
+
+// Set of integer keys on FlatHashTable: control bytes and keys only
+template <typename Key>
+using FlatHashSet = FlatHashTable<Key, void>;
+
+// Fixed-capacity multiset of integer keys: a count per key, linear probing over
+// parallel key and count arrays. remove() closes the gap by shifting later
+// entries of the probe run back instead of leaving tombstones, so lookups stay
+// short however many keys come and go. Holding at most `capacity` distinct keys
+// at once, it never allocates after construction.
+template <typename Key>
+class FlatCounter {
+public:
+    explicit FlatCounter(size_t capacity)
+        : keys_(std::bit_ceil(std::max<size_t>(2, capacity * 2))), counts_(keys_.size(), 0),
+          shift_(64 - std::countr_zero(keys_.size())) {}
+
+    uint32_t count(Key key) const {
+        for (size_t slot = home(key);; slot = next(slot)) {
+            if (counts_[slot] == 0) return 0;
+            if (keys_[slot] == key) return counts_[slot];
+        }
+    }
+
+    void add(Key key) {
+        for (size_t slot = home(key);; slot = next(slot)) {
+            if (counts_[slot] == 0) {
+                keys_[slot] = key;
+                counts_[slot] = 1;
+                return;
+            }
+            if (keys_[slot] == key) {
+                ++counts_[slot];
+                return;
+            }
+        }
+    }
+
+    // Remove one occurrence of a key that is present
+    void remove(Key key) {
+        size_t slot = home(key);
+        while (keys_[slot] != key || counts_[slot] == 0) slot = next(slot);
+        if (--counts_[slot] > 0) return;
+
+        // Move back every later entry of the run whose home is not between the
+        // hole and its own slot, which would strand it behind the hole
+        for (size_t hole = slot, later = next(slot); counts_[later] != 0; later = next(later)) {
+            size_t wanted = home(keys_[later]);
+            bool reachable = hole <= later ? (hole < wanted && wanted <= later) : (hole < wanted || wanted <= later);
+            if (reachable) continue;
+            keys_[hole] = keys_[later];
+            counts_[hole] = counts_[later];
+            counts_[later] = 0;
+            hole = later;
+        }
+    }
+
+    size_t memory_bytes() const { return keys_.size() * (sizeof(Key) + sizeof(uint32_t)); }
+
+private:
+    size_t home(Key key) const { return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> shift_); }
+    size_t next(size_t slot) const { return (slot + 1) & (keys_.size() - 1); }
+
+    std::vector<Key> keys_;
+    std::vector<uint32_t> counts_;  // 0 marks a free slot
+    unsigned shift_;
+};
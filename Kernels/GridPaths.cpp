@@ -0,0 +1,199 @@
+#include "GridPaths.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+
+// Run the tiles of the grid in wavefront order. edge_row holds, for every
+// column, the value of the cell above the tile being processed, and edge_col
+// the value of the cell to its left; a tile reads its slices and overwrites
+// them with its own last row and column. Tiles on one diagonal touch disjoint
+// slices, and a tile's successors only run on later diagonals.
+template <typename T, typename Rule>
+static void runWavefront(const PathGrid& grid, ThreadPool* pool, int tile, std::vector<T>& edge_row,
+    std::vector<T>& edge_col, Rule rule) {
+    int tile_rows = (grid.rows + tile - 1) / tile;
+    int tile_cols = (grid.cols + tile - 1) / tile;
+
+    // Four rows advance together, each one column behind the row above, so a
+    // cell's upper neighbour was written on the previous step and the four
+    // dependency chains through `left` overlap instead of running back to back
+    auto process = [&](int tile_row, int tile_col) {
+        int r0 = tile_row * tile, r1 = std::min(grid.rows, r0 + tile);
+        int c0 = tile_col * tile, c1 = std::min(grid.cols, c0 + tile);
+        int width = c1 - c0;
+        T* up = edge_row.data();
+        int r = r0;
+        for (; r + 4 <= r1; r += 4) {
+            T left[4] = { edge_col[r], edge_col[r + 1], edge_col[r + 2], edge_col[r + 3] };
+            size_t row_start[4];
+            for (int k = 0; k < 4; ++k) row_start[k] = static_cast<size_t>(r + k) * grid.cols;
+            auto cell = [&](int k, int c) {
+                left[k] = rule(up[c], left[k], row_start[k] + c);
+                up[c] = left[k];
+            };
+            auto checked_step = [&](int step) {
+                for (int k = 0; k < 4; ++k) {
+                    if (step - k >= 0 && step - k < width) cell(k, c0 + step - k);
+                }
+            };
+
+            int step = 0;
+            for (; step < 3; ++step) checked_step(step);
+            for (; step < width; ++step) {
+                cell(0, c0 + step);
+                cell(1, c0 + step - 1);
+                cell(2, c0 + step - 2);
+                cell(3, c0 + step - 3);
+            }
+            for (; step < width + 3; ++step) checked_step(step);
+            for (int k = 0; k < 4; ++k) edge_col[r + k] = left[k];
+        }
+        for (; r < r1; ++r) {
+            size_t row_start = static_cast<size_t>(r) * grid.cols;
+            T left = edge_col[r];
+            for (int c = c0; c < c1; ++c) {
+                left = rule(up[c], left, row_start + c);
+                up[c] = left;
+            }
+            edge_col[r] = left;
+        }
+    };
+
+    for (int diagonal = 0; diagonal < tile_rows + tile_cols - 1; ++diagonal) {
+        int first = std::max(0, diagonal - tile_cols + 1);
+        int last = std::min(diagonal, tile_rows - 1);
+        if (pool) {
+            pool->parallel_for(first, last + 1, [&](size_t tile_row) {
+                process(static_cast<int>(tile_row), diagonal - static_cast<int>(tile_row));
+                });
+        }
+        else {
+            for (int tile_row = first; tile_row <= last; ++tile_row) {
+                process(tile_row, diagonal - tile_row);
+            }
+        }
+    }
+}
+
+// Call run(blocked) with a lookup blocked(cell) for whichever representation the grid uses
+template <typename Run>
+static void withBlockedLookup(const PathGrid& grid, Run run) {
+    if (!grid.blocked.empty()) {
+        const uint8_t* bytes = grid.blocked.data();
+        run([bytes](size_t cell) { return bytes[cell] != 0; });
+    }
+    else {
+        const uint8_t* bits = grid.blocked_bits.data();
+        size_t first_bit = grid.first_bit;
+        run([bits, first_bit](size_t cell) {
+            size_t bit = first_bit + cell;
+            return ((bits[bit >> 3] >> (bit & 7)) & 1) != 0;
+            });
+    }
+}
+
+// Path counts of the grid's rows, continuing from the counts above them in edge_row
+static void countGridPathRows(const PathGrid& grid, ThreadPool* pool, uint32_t p, int tile,
+    std::vector<uint32_t>& edge_row) {
+    std::vector<uint32_t> edge_col(grid.rows, 0);
+    // Masks instead of branches: the obstacles are random, so branches would mispredict
+    withBlockedLookup(grid, [&](auto blocked) {
+        runWavefront(grid, pool, tile, edge_row, edge_col, [blocked, p](uint32_t up, uint32_t left, size_t cell) {
+            uint32_t sum = up + left;
+            sum = sum >= p ? sum - p : sum;
+            return sum & (0u - static_cast<uint32_t>(!blocked(cell)));
+            });
+        });
+}
+
+uint32_t countGridPaths(const PathGrid& grid, ThreadPool* pool, uint32_t p, int tile) {
+    if (grid.rows <= 0 || grid.cols <= 0) return 0;
+    // A virtual path enters the top-left cell from above
+    std::vector<uint32_t> edge_row(grid.cols, 0);
+    edge_row[0] = 1 % p;
+    countGridPathRows(grid, pool, p, tile, edge_row);
+    return edge_row[grid.cols - 1];
+}
+
+uint64_t minCostGridPath(const PathGrid& grid, ThreadPool* pool, int tile) {
+    if (grid.rows <= 0 || grid.cols <= 0) return UNREACHABLE_COST;
+    // Costs saturate at infinity; every value stays below 2^63, so adding a
+    // cell cost never wraps and no branch is needed
+    const uint64_t infinity = uint64_t(1) << 62;
+    std::vector<uint64_t> edge_row(grid.cols, infinity), edge_col(grid.rows, infinity);
+    edge_row[0] = 0;
+
+    const uint32_t* cost = grid.cost.data();
+    withBlockedLookup(grid, [&](auto blocked) {
+        runWavefront(grid, pool, tile, edge_row, edge_col, [blocked, cost, infinity](uint64_t up, uint64_t left, size_t cell) {
+            uint64_t value = std::min(std::min(up, left) + cost[cell], infinity);
+            return value | (infinity & (0 - static_cast<uint64_t>(blocked(cell))));
+            });
+        });
+    return edge_row[grid.cols - 1] >= infinity ? UNREACHABLE_COST : edge_row[grid.cols - 1];
+}
+
+// Header fields as little-endian uint32 words
+static void putWord(unsigned char* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+static uint32_t getWord(const unsigned char* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+void writeGridBitmap(const std::string& path, const PathGrid& grid) {
+    size_t cells = static_cast<size_t>(grid.rows) * grid.cols;
+    std::vector<unsigned char> file(GRID_BITMAP_HEADER_SIZE + (cells + 7) / 8, 0);
+    std::memcpy(file.data(), "DPGB", 4);
+    putWord(&file[4], grid.rows);
+    putWord(&file[8], grid.cols);
+    withBlockedLookup(grid, [&](auto blocked) {
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (blocked(cell)) file[GRID_BITMAP_HEADER_SIZE + cell / 8] |= 1 << (cell % 8);
+        }
+        });
+    writeBinaryFile(path, file.data(), file.size());
+}
+
+// Rows and columns from a bitmap header
+static std::pair<int, int> readGridBitmapHeader(const MappedFile& header) {
+    if (header.size() < GRID_BITMAP_HEADER_SIZE || std::memcmp(header.data(), "DPGB", 4) != 0) {
+        throw std::runtime_error("not a grid bitmap file");
+    }
+    return { static_cast<int>(getWord(header.data() + 4)), static_cast<int>(getWord(header.data() + 8)) };
+}
+
+PathGrid mapGridBitmap(const MappedFile& file) {
+    PathGrid grid;
+    std::tie(grid.rows, grid.cols) = readGridBitmapHeader(file);
+    size_t cells = static_cast<size_t>(grid.rows) * grid.cols;
+    if (file.size() < GRID_BITMAP_HEADER_SIZE + (cells + 7) / 8) {
+        throw std::runtime_error("grid bitmap file is truncated");
+    }
+    grid.blocked_bits = file.elements<uint8_t>(GRID_BITMAP_HEADER_SIZE);
+    return grid;
+}
+
+uint32_t countGridPathsStreaming(const std::string& path, int chunk_rows, ThreadPool* pool, uint32_t p, int tile) {
+    auto [rows, cols] = readGridBitmapHeader(MappedFile(path, 0, GRID_BITMAP_HEADER_SIZE));
+    if (rows <= 0 || cols <= 0) return 0;
+    std::vector<uint32_t> edge_row(cols, 0);
+    edge_row[0] = 1 % p;
+
+    for (int first_row = 0; first_row < rows; first_row += chunk_rows) {
+        PathGrid chunk;
+        chunk.rows = std::min(chunk_rows, rows - first_row);
+        chunk.cols = cols;
+        // Map the bytes holding the chunk's bits; its first cell may start mid-byte
+        size_t first_bit = static_cast<size_t>(first_row) * cols;
+        size_t end_bit = first_bit + static_cast<size_t>(chunk.rows) * cols;
+        MappedFile window(path, GRID_BITMAP_HEADER_SIZE + first_bit / 8, (end_bit + 7) / 8 - first_bit / 8);
+        chunk.blocked_bits = window.elements<uint8_t>();
+        chunk.first_bit = first_bit % 8;
+        countGridPathRows(chunk, pool, p, tile, edge_row);
+    }
+    return edge_row[cols - 1];
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "ModularArithmetic.h"
+#include "ThreadPool.h"
+
+// Side of the square tiles the grid engine works on; a tile's boundary row
+// and column stay in L1 while its cells are processed
+const int GRID_TILE = 256;
+
+// Row-major occupancy grid with optional per-cell costs. Paths start at the
+// top-left cell, end at the bottom-right cell and move right or down.
+struct PathGrid {
+    int rows = 0;
+    int cols = 0;
+    std::vector<uint8_t> blocked;  // non-zero cells cannot be entered
+    std::vector<uint32_t> cost;    // cost of entering each cell, only needed for minCostGridPath
+
+    // Used instead of blocked when that is empty, e.g. over a mapped bitmap:
+    // cell i is blocked when bit first_bit + i is set, least significant bit first
+    std::span<const uint8_t> blocked_bits;
+    size_t first_bit = 0;
+
+    PathGrid() = default;
+    PathGrid(int rows, int cols) : rows(rows), cols(cols), blocked(static_cast<size_t>(rows) * cols, 0) {}
+};
+
+// Returned by minCostGridPath when every path is blocked
+const uint64_t UNREACHABLE_COST = UINT64_MAX;
+
+// Number of paths around the blocked cells mod p. Tiles run in anti-diagonal
+// wavefront order: every tile on one diagonal only needs the tiles above and to
+// its left, so a diagonal's tiles are spread over the pool.
+uint32_t countGridPaths(const PathGrid& grid, ThreadPool* pool = nullptr, uint32_t p = DEFAULT_MODULUS,
+    int tile = GRID_TILE);
+
+// Smallest total cost of a path, counting every cell entered including both
+// ends, or UNREACHABLE_COST; same wavefront as countGridPaths
+uint64_t minCostGridPath(const PathGrid& grid, ThreadPool* pool = nullptr, int tile = GRID_TILE);
+
+// Grid bitmap files hold a 16-byte header ("DPGB", then rows, cols and 0 as
+// little-endian uint32) followed by one bit per cell in the layout of blocked_bits
+const size_t GRID_BITMAP_HEADER_SIZE = 16;
+
+void writeGridBitmap(const std::string& path, const PathGrid& grid);
+
+// Grid over a mapped bitmap file, without copying; the mapping must outlive the
+// grid. Throws std::runtime_error when the file is not a grid bitmap.
+PathGrid mapGridBitmap(const MappedFile& file);
+
+// countGridPaths over a bitmap file, mapping chunk_rows rows at a time so grids
+// larger than RAM need only one chunk and one row of counts in memory
+uint32_t countGridPathsStreaming(const std::string& path, int chunk_rows, ThreadPool* pool = nullptr,
+    uint32_t p = DEFAULT_MODULUS, int tile = GRID_TILE);
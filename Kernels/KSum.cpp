@@ -0,0 +1,161 @@
+#include "KSum.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+#include "TwoSum.h"
+
+#if defined(DP_X86)
+#include <immintrin.h>
+#endif
+
+// Search sorted[first..] for k values adding up to targetSum, appending their
+// positions; the sorted order bounds every partial sum from both sides
+static bool kSumSorted(std::span<const int> sorted, size_t first, int k, int64_t targetSum,
+    std::vector<size_t>& positions) {
+    size_t n = sorted.size();
+    if (n - first < size_t(k)) return false;
+    if (k == 1) {
+        auto found = std::lower_bound(sorted.begin() + first, sorted.end(), targetSum,
+            [](int value, int64_t target) { return value < target; });
+        if (found == sorted.end() || *found != targetSum) return false;
+        positions.push_back(found - sorted.begin());
+        return true;
+    }
+    if (k == 2) {
+        auto pair = sortedPairPositions(sorted.subspan(first), targetSum);
+        if (!pair) return false;
+        positions.push_back(first + pair->first);
+        positions.push_back(first + pair->second);
+        return true;
+    }
+
+    int64_t largestRest = 0;
+    for (int j = 1; j < k; ++j) largestRest += sorted[n - j];
+    for (size_t i = first; i + k <= n; ++i) {
+        // The same value again leads to the same sub-search
+        if (i > first && sorted[i] == sorted[i - 1]) continue;
+        int64_t smallest = 0;
+        for (int j = 0; j < k; ++j) smallest += sorted[i + j];
+        if (smallest > targetSum) break;
+        if (sorted[i] + largestRest < targetSum) continue;
+        positions.push_back(i);
+        if (kSumSorted(sorted, i + 1, k - 1, targetSum - sorted[i], positions)) return true;
+        positions.pop_back();
+    }
+    return false;
+}
+
+std::optional<std::vector<size_t>> IndicesKSum(std::span<const int> sequence, int k, int64_t targetSum,
+    ThreadPool* pool) {
+    if (k < 1 || sequence.size() < size_t(k)) return std::nullopt;
+    std::vector<int> sorted;
+    std::vector<size_t> indices;
+    sortWithIndices(sequence, sorted, indices);
+
+    std::vector<size_t> positions;
+    if (!pool || k < 3) {
+        if (!kSumSorted(sorted, 0, k, targetSum, positions)) return std::nullopt;
+    }
+    else {
+        // Each first value is searched on its own; the smallest first position
+        // with an answer wins, and later ones stop early once it is known
+        std::atomic<size_t> best{ std::numeric_limits<size_t>::max() };
+        std::mutex mutex;
+        int64_t largestRest = 0;
+        for (int j = 1; j < k; ++j) largestRest += sorted[sorted.size() - j];
+        pool->parallel_for(0, sorted.size() - k + 1, [&](size_t i) {
+            if (i >= best.load(std::memory_order_relaxed)) return;
+            if (i > 0 && sorted[i] == sorted[i - 1]) return;
+            if (sorted[i] + largestRest < targetSum) return;
+            std::vector<size_t> found{ i };
+            if (!kSumSorted(sorted, i + 1, k - 1, targetSum - sorted[i], found)) return;
+            std::lock_guard<std::mutex> lock(mutex);
+            if (i < best.load(std::memory_order_relaxed)) {
+                best.store(i, std::memory_order_relaxed);
+                positions = std::move(found);
+            }
+            }, 1);
+        if (positions.empty()) return std::nullopt;
+    }
+
+    std::vector<size_t> result(positions.size());
+    for (size_t j = 0; j < positions.size(); ++j) result[j] = indices[positions[j]];
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// dst[w] = src[w] | (src << shift)[w] for w in [first, last], from the top word
+// down, so src and dst may be the same array. shift = 64 * words + bits.
+static void shiftOrScalar(const uint64_t* src, uint64_t* dst, size_t first, size_t last, size_t words, unsigned bits) {
+    for (size_t w = last + 1; w-- > first;) {
+        uint64_t shifted = 0;
+        if (w >= words) {
+            shifted = src[w - words] << bits;
+            if (bits && w > words) shifted |= src[w - words - 1] >> (64 - bits);
+        }
+        dst[w] = src[w] | shifted;
+    }
+}
+
+#if defined(DP_X86)
+DP_TARGET_AVX2 static void shiftOrAvx2(const uint64_t* src, uint64_t* dst, size_t first, size_t last, size_t words,
+    unsigned bits) {
+    __m128i left = _mm_cvtsi32_si128(static_cast<int>(bits));
+    __m128i right = _mm_cvtsi32_si128(static_cast<int>(64 - bits));  // a count of 64 gives 0
+    // Blocks [w, w + 4) whose source words, including the one below, exist;
+    // every load precedes the store, and the words below are not yet updated
+    size_t end = last + 1;
+    while (end >= first + 4 && end >= words + 5) {
+        end -= 4;
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + end - words));
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + end - words - 1));
+        __m256i shifted = _mm256_or_si256(_mm256_sll_epi64(high, left), _mm256_srl_epi64(low, right));
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + end));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + end), _mm256_or_si256(current, shifted));
+    }
+    if (end > first) shiftOrScalar(src, dst, first, end - 1, words, bits);
+}
+#endif
+
+bool subsetSumBitset(std::span<const int> values, int64_t targetSum, ThreadPool* pool, SimdLevel level) {
+    if (targetSum < 0) return false;
+    if (targetSum == 0) return true;
+    size_t targetWord = targetSum / 64;
+    uint64_t targetBit = uint64_t(1) << (targetSum % 64);
+    std::vector<uint64_t> bits(targetWord + 1, 0), next;
+    bits[0] = 1;
+    auto shiftOr = shiftOrScalar;
+#if defined(DP_X86)
+    if (supportedSimdLevel(level) >= SimdLevel::Avx2) shiftOr = shiftOrAvx2;
+#endif
+
+    int64_t reach = 0;  // largest sum reachable so far, capped at targetSum
+    for (int value : values) {
+        if (value <= 0 || value > targetSum) continue;
+        reach = std::min(targetSum, reach + value);
+        size_t top = reach / 64;
+        size_t words = value / 64;
+        unsigned shift = value % 64;
+        if (!pool || pool->size() == 1 || top < 2 * SUBSET_SUM_PARALLEL_WORDS) {
+            shiftOr(bits.data(), bits.data(), 0, top, words, shift);
+        }
+        else {
+            // Tasks may not read words another task is writing, so the update
+            // goes to a second bitset. Words above top are zero in both, since
+            // top never goes down.
+            next.resize(bits.size());
+            size_t tasks = (top + SUBSET_SUM_PARALLEL_WORDS) / SUBSET_SUM_PARALLEL_WORDS;
+            pool->parallel_for(0, tasks, [&](size_t task) {
+                size_t first = task * SUBSET_SUM_PARALLEL_WORDS;
+                size_t last = std::min(top, first + SUBSET_SUM_PARALLEL_WORDS - 1);
+                shiftOr(bits.data(), next.data(), first, last, words, shift);
+                }, 1);
+            bits.swap(next);
+        }
+        if (bits[targetWord] & targetBit) return true;
+    }
+    return false;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+// Original indices, ascending, of k elements of sequence adding up to targetSum
+// (in 64 bits), or nullopt. The values are radix-sorted once; each level of the
+// search fixes one value, skipping repeats and stopping as soon as the k smallest
+// remaining values are too large, and the last two values come from the Two-Sum
+// sweep over the sorted suffix (sortedPairPositions). O(n^(k-1)) in the worst
+// case. With a pool, the choices for the first value are split across its threads;
+// the answer is the one the sequential search finds.
+std::optional<std::vector<size_t>> IndicesKSum(std::span<const int> sequence, int k, int64_t targetSum,
+    ThreadPool* pool = nullptr);
+
+// Words per parallel task in subsetSumBitset; bitsets under twice this many
+// words are updated on the caller
+const size_t SUBSET_SUM_PARALLEL_WORDS = 1 << 14;
+
+// Whether some subset of values (each used at most once) adds up to targetSum.
+// Values must be non-negative. A bitset of reachable sums is updated with
+// bits |= bits << v for each value, 4 words at a time with AVX2; the update only
+// covers sums reachable so far and stops as soon as targetSum is reached.
+// O(n * targetSum / 64) time and targetSum / 8 bytes. With a pool, wide bitsets
+// are split into word ranges updated in parallel.
+bool subsetSumBitset(std::span<const int> values, int64_t targetSum, ThreadPool* pool = nullptr,
+    SimdLevel level = bestSimdLevel());
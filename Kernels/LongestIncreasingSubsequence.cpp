@@ -0,0 +1,421 @@
+#include "LongestIncreasingSubsequence.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+#if defined(DP_X86)
+#include <immintrin.h>
+#endif
+
+// Length of the longest increasing subsequence among masks [first, last). Element
+// i is bit n - 1 - i, so masks that share their high bits share a prefix of the
+// array and form one contiguous range. Walking a mask from its highest bit checks
+// the order without building the subsequence; when element j is not larger than
+// the one before it, every mask with the same bits from j upwards fails as well,
+// and the whole range is skipped.
+static int bruteForceMaskRange(const int* values, int n, uint64_t first, uint64_t last) {
+    int maxLen = 0;
+    for (uint64_t mask = std::max<uint64_t>(first, 1); mask < last;) {
+        int top = 63 - std::countl_zero(mask);
+        int previous = values[n - 1 - top];
+        uint64_t rest = mask ^ (uint64_t(1) << top);
+        int length = 1;
+        bool isIncreasing = true;
+        while (rest) {
+            int bit = 63 - std::countl_zero(rest);
+            int value = values[n - 1 - bit];
+            if (value <= previous) {
+                mask = (mask | ((uint64_t(1) << bit) - 1)) + 1;
+                isIncreasing = false;
+                break;
+            }
+            previous = value;
+            rest ^= uint64_t(1) << bit;
+            ++length;
+        }
+        if (isIncreasing) {
+            maxLen = std::max(maxLen, length);
+            ++mask;
+        }
+    }
+    return maxLen;
+}
+
+// Iterative Brute Force LIS function
+int longestIncreasingSubsequenceBruteForce(std::span<const int> arr, ThreadPool* pool) {
+    if (arr.size() >= 64) {
+        throw std::invalid_argument("brute-force LIS needs fewer than 64 elements");
+    }
+    int n = static_cast<int>(arr.size());
+    if (n == 0) return 0;
+    uint64_t masks = uint64_t(1) << n;
+    if (!pool || n < 16) {
+        return bruteForceMaskRange(arr.data(), n, 1, masks);
+    }
+
+    // 256 ranges of masks with fixed high bits, stolen between threads as the
+    // pruning makes some of them far cheaper than others
+    const int prefixBits = 8;
+    std::vector<int> best(size_t(1) << prefixBits);
+    uint64_t rangeSize = masks >> prefixBits;
+    pool->parallel_for(0, best.size(), [&](size_t range) {
+        best[range] = bruteForceMaskRange(arr.data(), n, range * rangeSize, (range + 1) * rangeSize);
+        }, 1);
+    return *std::max_element(best.begin(), best.end());
+}
+
+// Extend an increasing subsequence ending at index last by every later, larger
+// element. Branches that could not beat best even by taking every remaining
+// element are cut.
+static void extendIncreasing(const int* values, int n, int last, int length, int& best) {
+    best = std::max(best, length);
+    for (int j = last + 1; j < n && length + (n - j) > best; ++j) {
+        if (values[j] > values[last]) {
+            extendIncreasing(values, n, j, length + 1, best);
+        }
+    }
+}
+
+int longestIncreasingSubsequenceBranchAndBound(std::span<const int> arr, ThreadPool* pool) {
+    int n = arr.size();
+    std::atomic<int> best{ 0 };
+    auto start = [&](size_t first) {
+        // Start from the best length any thread has found so far
+        int local = best.load(std::memory_order_relaxed);
+        if (n - static_cast<int>(first) <= local) return;
+        extendIncreasing(arr.data(), n, static_cast<int>(first), 1, local);
+        int current = best.load(std::memory_order_relaxed);
+        while (local > current && !best.compare_exchange_weak(current, local, std::memory_order_relaxed)) {}
+    };
+    if (pool) {
+        pool->parallel_for(0, n, start, 1);
+    }
+    else {
+        for (int first = 0; first < n; ++first) start(first);
+    }
+    return best.load();
+}
+
+// Recursive function to find the length of LIS ending at index i with memoization
+int LIS(int i, const std::vector<int>& arr, std::vector<int>& dp) {
+    if (dp[i] != -1) return dp[i];
+
+    int maxLength = 1; // Minimum LIS ending at index i is 1
+    for (int j = 0; j < i; ++j) {
+        if (arr[j] < arr[i]) {
+            maxLength = std::max(maxLength, LIS(j, arr, dp) + 1);
+        }
+    }
+    dp[i] = maxLength;
+    return dp[i];
+}
+
+// Function to find the length of the Longest Increasing Subsequence using memoization
+int longestIncreasingSubsequenceMemoization(const std::vector<int>& arr) {
+    int n = arr.size();
+    if (n == 0) return 0;
+
+    std::vector<int> dp(n, -1);
+    int maxLength = 1;
+    for (int i = 0; i < n; ++i) {
+        maxLength = std::max(maxLength, LIS(i, arr, dp));
+    }
+
+    return maxLength;
+}
+
+// Function to find the length of the Longest Increasing Subsequence using tabulation
+template <typename T>
+static int tabulationLIS(std::span<const T> arr) {
+    int n = arr.size();
+    if (n == 0) return 0;
+
+    std::vector<int> dp(n, 1);
+    int maxLength = 1;
+
+    for (int i = 1; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (arr[i] > arr[j]) {
+                dp[i] = std::max(dp[i], dp[j] + 1);
+            }
+        }
+        maxLength = std::max(maxLength, dp[i]);
+    }
+
+    return maxLength;
+}
+
+int longestIncreasingSubsequenceTabulation(std::span<const int> arr) {
+    return tabulationLIS(arr);
+}
+
+int longestIncreasingSubsequenceTabulation(std::span<const int64_t> arr) {
+    return tabulationLIS(arr);
+}
+
+// Tabulation with the comparison folded into the maximum instead of a branch
+static int tabulationLISScalar(std::span<const int> arr) {
+    int n = arr.size();
+    if (n == 0) return 0;
+
+    std::vector<int> dp(n, 1);
+    int maxLength = 1;
+    for (int i = 1; i < n; ++i) {
+        int x = arr[i];
+        int best = 0;
+        for (int j = 0; j < i; ++j) {
+            best = std::max(best, arr[j] < x ? dp[j] : 0);
+        }
+        dp[i] = best + 1;
+        maxLength = std::max(maxLength, dp[i]);
+    }
+    return maxLength;
+}
+
+#if defined(DP_X86)
+DP_TARGET_AVX2 static int tabulationLISAvx2(std::span<const int> arr) {
+    int n = arr.size();
+    if (n == 0) return 0;
+
+    std::vector<int> dp(n, 1);
+    const int* values = arr.data();
+    int maxLength = 1;
+    for (int i = 1; i < n; ++i) {
+        __m256i x = _mm256_set1_epi32(values[i]);
+        // Two accumulators so consecutive maxima do not wait on each other
+        __m256i best0 = _mm256_setzero_si256(), best1 = _mm256_setzero_si256();
+        int j = 0;
+        for (; j + 16 <= i; j += 16) {
+            __m256i smaller0 = _mm256_cmpgt_epi32(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j)));
+            __m256i smaller1 = _mm256_cmpgt_epi32(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j + 8)));
+            best0 = _mm256_max_epi32(best0, _mm256_and_si256(smaller0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&dp[j]))));
+            best1 = _mm256_max_epi32(best1, _mm256_and_si256(smaller1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&dp[j + 8]))));
+        }
+        if (j + 8 <= i) {
+            __m256i smaller = _mm256_cmpgt_epi32(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j)));
+            best0 = _mm256_max_epi32(best0, _mm256_and_si256(smaller, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&dp[j]))));
+            j += 8;
+        }
+        __m256i best = _mm256_max_epi32(best0, best1);
+        __m128i half = _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+        int longest = _mm_cvtsi128_si32(half);
+        for (; j < i; ++j) {
+            longest = std::max(longest, values[j] < values[i] ? dp[j] : 0);
+        }
+        dp[i] = longest + 1;
+        maxLength = std::max(maxLength, dp[i]);
+    }
+    return maxLength;
+}
+
+DP_TARGET_AVX512 static int tabulationLISAvx512(std::span<const int> arr) {
+    int n = arr.size();
+    if (n == 0) return 0;
+
+    std::vector<int> dp(n, 1);
+    const int* values = arr.data();
+    int maxLength = 1;
+    for (int i = 1; i < n; ++i) {
+        __m512i x = _mm512_set1_epi32(values[i]);
+        __m512i best0 = _mm512_setzero_si512(), best1 = _mm512_setzero_si512();
+        int j = 0;
+        for (; j + 32 <= i; j += 32) {
+            __mmask16 smaller0 = _mm512_cmpgt_epi32_mask(x, _mm512_loadu_si512(values + j));
+            __mmask16 smaller1 = _mm512_cmpgt_epi32_mask(x, _mm512_loadu_si512(values + j + 16));
+            best0 = _mm512_mask_max_epi32(best0, smaller0, best0, _mm512_loadu_si512(&dp[j]));
+            best1 = _mm512_mask_max_epi32(best1, smaller1, best1, _mm512_loadu_si512(&dp[j + 16]));
+        }
+        if (j + 16 <= i) {
+            __mmask16 smaller = _mm512_cmpgt_epi32_mask(x, _mm512_loadu_si512(values + j));
+            best0 = _mm512_mask_max_epi32(best0, smaller, best0, _mm512_loadu_si512(&dp[j]));
+            j += 16;
+        }
+        // Reduce through 256 and 128 bits; the mask forms take an explicit source
+        // and avoid GCC's uninitialized warnings about _mm512_undefined
+        __m512i best = _mm512_mask_max_epi32(best0, 0xFFFF, best0, best1);
+        __m256i quarter = _mm256_max_epi32(_mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xF, best, 0),
+            _mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xF, best, 1));
+        __m128i half = _mm_max_epi32(_mm256_castsi256_si128(quarter), _mm256_extracti128_si256(quarter, 1));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+        int longest = _mm_cvtsi128_si32(half);
+        // Fewer than 16 left: one 8-lane step, then scalar
+        if (j + 8 <= i) {
+            __m256i smaller = _mm256_cmpgt_epi32(_mm256_set1_epi32(values[i]),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j)));
+            __m256i candidates = _mm256_and_si256(smaller, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&dp[j])));
+            __m128i tail = _mm_max_epi32(_mm256_castsi256_si128(candidates), _mm256_extracti128_si256(candidates, 1));
+            tail = _mm_max_epi32(tail, _mm_shuffle_epi32(tail, 0x4E));
+            tail = _mm_max_epi32(tail, _mm_shuffle_epi32(tail, 0xB1));
+            longest = std::max(longest, _mm_cvtsi128_si32(tail));
+            j += 8;
+        }
+        for (; j < i; ++j) {
+            longest = std::max(longest, values[j] < values[i] ? dp[j] : 0);
+        }
+        dp[i] = longest + 1;
+        maxLength = std::max(maxLength, dp[i]);
+    }
+    return maxLength;
+}
+#endif
+
+int longestIncreasingSubsequenceTabulationSimd(std::span<const int> arr, SimdLevel level) {
+    switch (supportedSimdLevel(level)) {
+#if defined(DP_X86)
+    case SimdLevel::Avx512: return tabulationLISAvx512(arr);
+    case SimdLevel::Avx2: return tabulationLISAvx2(arr);
+#endif
+    default: return tabulationLISScalar(arr);
+    }
+}
+
+// Position of the first tail that is not smaller than x. The search range halves
+// with a conditional move instead of a branch, so random input does not
+// mispredict; the loop count depends only on the number of tails.
+template <typename T>
+static size_t lowerBoundBranchless(const T* tails, size_t count, T x) {
+    if (count == 0) return 0;
+    const T* base = tails;
+    while (count > 1) {
+        size_t half = count / 2;
+        base = base[half] < x ? base + half : base;
+        count -= half;
+    }
+    return (base - tails) + (*base < x);
+}
+
+// Function to find the length of the Longest Increasing Subsequence by patience sorting
+template <typename T>
+static int patienceLIS(std::span<const T> arr) {
+    std::vector<T> tails;
+    for (T x : arr) {
+        if (tails.empty() || tails.back() < x) {
+            tails.push_back(x);
+        }
+        else {
+            tails[lowerBoundBranchless(tails.data(), tails.size(), x)] = x;
+        }
+    }
+    return static_cast<int>(tails.size());
+}
+
+int longestIncreasingSubsequencePatience(std::span<const int> arr) {
+    return patienceLIS(arr);
+}
+
+int longestIncreasingSubsequencePatience(std::span<const int64_t> arr) {
+    return patienceLIS(arr);
+}
+
+// Function to find one Longest Increasing Subsequence by patience sorting.
+// Each element records the index of the tail one shorter than its own position,
+// which is its predecessor in a longest run ending at it. Index is uint32_t
+// when it can address arr, halving the link array.
+template <typename T, typename Index>
+static std::vector<T> patienceReconstruct(std::span<const T> arr) {
+    std::vector<T> tails;
+    std::vector<Index> tailIndex;  // index in arr of each tail
+    std::vector<Index> previous(arr.size());
+    const Index none = std::numeric_limits<Index>::max();
+
+    for (Index i = 0; i < arr.size(); ++i) {
+        size_t position = (tails.empty() || tails.back() < arr[i])
+            ? tails.size() : lowerBoundBranchless(tails.data(), tails.size(), arr[i]);
+        previous[i] = position > 0 ? tailIndex[position - 1] : none;
+        if (position == tails.size()) {
+            tails.push_back(arr[i]);
+            tailIndex.push_back(i);
+        }
+        else {
+            tails[position] = arr[i];
+            tailIndex[position] = i;
+        }
+    }
+
+    std::vector<T> sequence(tails.size());
+    Index index = tailIndex.empty() ? none : tailIndex.back();
+    for (size_t k = sequence.size(); k-- > 0; index = previous[index]) {
+        sequence[k] = arr[index];
+    }
+    return sequence;
+}
+
+std::vector<int> longestIncreasingSubsequenceReconstruct(std::span<const int> arr) {
+    if (arr.size() < UINT32_MAX) return patienceReconstruct<int, uint32_t>(arr);
+    return patienceReconstruct<int, size_t>(arr);
+}
+
+std::vector<int64_t> longestIncreasingSubsequenceReconstruct(std::span<const int64_t> arr) {
+    if (arr.size() < UINT32_MAX) return patienceReconstruct<int64_t, uint32_t>(arr);
+    return patienceReconstruct<int64_t, size_t>(arr);
+}
+
+// Patience sorting into a caller-owned buffer with room for arr.size() tails
+static int patienceLISInto(std::span<const int> arr, int* tails) {
+    size_t count = 0;
+    for (int x : arr) {
+        size_t position = count > 0 && tails[count - 1] < x ? count : lowerBoundBranchless(tails, count, x);
+        tails[position] = x;
+        count += position == count;
+    }
+    return static_cast<int>(count);
+}
+
+void longestIncreasingSubsequenceBatch(std::span<const int> values, std::span<const size_t> offsets,
+    std::span<int> lengths, ThreadPool* pool) {
+    if (offsets.size() < 2) return;
+    size_t sequences = offsets.size() - 1;
+    auto block = [&](size_t b) {
+        // One buffer per thread, grown to the longest sequence it has seen
+        thread_local std::vector<int> tails;
+        size_t first = b * LIS_BATCH_BLOCK, last = std::min(sequences, first + LIS_BATCH_BLOCK);
+        for (size_t s = first; s < last; ++s) {
+            std::span<const int> sequence = values.subspan(offsets[s], offsets[s + 1] - offsets[s]);
+            if (tails.size() < sequence.size()) tails.resize(sequence.size());
+            lengths[s] = patienceLISInto(sequence, tails.data());
+        }
+    };
+    size_t blocks = (sequences + LIS_BATCH_BLOCK - 1) / LIS_BATCH_BLOCK;
+    if (pool) {
+        pool->parallel_for(0, blocks, block, 1);
+    }
+    else {
+        for (size_t b = 0; b < blocks; ++b) block(b);
+    }
+}
+
+void OnlineLIS::append(int x) {
+    if (tails_.empty() || tails_.back() < x) {
+        tails_.push_back(x);
+    }
+    else {
+        tails_[lowerBoundBranchless(tails_.data(), tails_.size(), x)] = x;
+    }
+}
+
+void SlidingWindowLIS::append(int x) {
+    if (values_.empty()) return;
+    values_[next_] = x;
+    next_ = (next_ + 1) % values_.size();
+    count_ = std::min(count_ + 1, values_.size());
+
+    // Oldest to newest: the oldest element sits at next_ once the ring is full
+    size_t start = count_ == values_.size() ? next_ : 0;
+    tails_.clear();
+    for (size_t k = 0, i = start; k < count_; ++k, i = (i + 1 == values_.size() ? 0 : i + 1)) {
+        int value = values_[i];
+        if (tails_.empty() || tails_.back() < value) {
+            tails_.push_back(value);
+        }
+        else {
+            tails_[lowerBoundBranchless(tails_.data(), tails_.size(), value)] = value;
+        }
+    }
+    length_ = static_cast<int>(tails_.size());
+}
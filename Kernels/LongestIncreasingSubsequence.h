@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+// Iterative Brute Force LIS function: checks every subset of the elements as a
+// 64-bit mask, so arr must have fewer than 64 elements; longer inputs throw
+// std::invalid_argument. Masks that share a failing prefix are skipped together
+// and nothing is allocated per mask; with a pool, ranges of masks run in
+// parallel. Meant as a ground truth for the faster variants.
+int longestIncreasingSubsequenceBruteForce(std::span<const int> arr, ThreadPool* pool = nullptr);
+
+// Exhaustive search over increasing subsequences only, cutting branches that
+// cannot beat the best length found so far. With a pool, the subsequences
+// starting at each element are searched in parallel and share that bound.
+int longestIncreasingSubsequenceBranchAndBound(std::span<const int> arr, ThreadPool* pool = nullptr);
+
+// Recursive function to find the length of LIS ending at index i with memoization
+int LIS(int i, const std::vector<int>& arr, std::vector<int>& dp);
+
+// Function to find the length of the Longest Increasing Subsequence using memoization
+int longestIncreasingSubsequenceMemoization(const std::vector<int>& arr);
+
+// Function to find the length of the Longest Increasing Subsequence using tabulation.
+// Spans let the same code run on vectors and on mapped int32/int64 files.
+int longestIncreasingSubsequenceTabulation(std::span<const int> arr);
+int longestIncreasingSubsequenceTabulation(std::span<const int64_t> arr);
+
+// Function to find the length of the Longest Increasing Subsequence using tabulation,
+// comparing 8 (AVX2) or 16 (AVX-512) earlier elements at a time: a lane mask of
+// arr[j] < arr[i] selects dp[j] for a running maximum. Scalar is a branchless loop.
+// Levels the machine lacks fall back to the widest one it has.
+int longestIncreasingSubsequenceTabulationSimd(std::span<const int> arr, SimdLevel level = bestSimdLevel());
+
+// Function to find the length of the Longest Increasing Subsequence by patience
+// sorting: tails[k] is the smallest value ending an increasing run of length
+// k + 1, and each element replaces the first tail that is not smaller. O(n log n)
+// time, O(LIS) memory.
+int longestIncreasingSubsequencePatience(std::span<const int> arr);
+int longestIncreasingSubsequencePatience(std::span<const int64_t> arr);
+
+// Function to find one Longest Increasing Subsequence by patience sorting,
+// following predecessor links back from the last tail. O(n) extra memory.
+std::vector<int> longestIncreasingSubsequenceReconstruct(std::span<const int> arr);
+std::vector<int64_t> longestIncreasingSubsequenceReconstruct(std::span<const int64_t> arr);
+
+// Sequences handed to a thread at a time by longestIncreasingSubsequenceBatch
+const size_t LIS_BATCH_BLOCK = 64;
+
+// Lengths of the Longest Increasing Subsequence of many sequences stored back to
+// back (CSR layout): sequence s is values[offsets[s], offsets[s + 1]) and its length
+// goes to lengths[s]. Patience sorting runs in a per-thread buffer of tails, so
+// nothing is allocated per sequence; with a pool, blocks of sequences are spread
+// over its threads, which steal blocks from each other when lengths are uneven.
+void longestIncreasingSubsequenceBatch(std::span<const int> values, std::span<const size_t> offsets,
+    std::span<int> lengths, ThreadPool* pool = nullptr);
+
+// Longest Increasing Subsequence of a stream: append keeps the patience-sorting
+// tails up to date in O(log LIS), so the length is known after every element
+class OnlineLIS {
+public:
+    void append(int x);
+    int length() const { return static_cast<int>(tails_.size()); }
+    void clear() { tails_.clear(); }
+
+private:
+    std::vector<int> tails_;
+};
+
+// Longest Increasing Subsequence of the last `window` elements of a stream.
+// Dropping the oldest element can shorten runs anywhere in the tails, so each
+// append rebuilds them over the ring buffer: O(window log LIS) per element,
+// without allocating after the window has filled.
+class SlidingWindowLIS {
+public:
+    explicit SlidingWindowLIS(size_t window) : values_(window) {}
+
+    void append(int x);
+    int length() const { return length_; }
+
+private:
+    std::vector<int> values_;  // ring buffer of the window
+    std::vector<int> tails_;
+    size_t next_ = 0;          // ring position of the next element
+    size_t count_ = 0;         // elements in the window
+    int length_ = 0;
+};
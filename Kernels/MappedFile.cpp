@@ -0,0 +1,145 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+    map(path, 0, 0);
+}
+
+MappedFile::MappedFile(const std::string& path, uint64_t offset, size_t length) {
+    map(path, offset, length);
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+    base_(std::exchange(other.base_, nullptr)), mapped_(std::exchange(other.mapped_, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        base_ = std::exchange(other.base_, nullptr);
+        mapped_ = std::exchange(other.mapped_, 0);
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+uint64_t MappedFile::file_size(const std::string& path) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) {
+        throw std::runtime_error("cannot stat " + path);
+    }
+    return (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+}
+
+void MappedFile::map(const std::string& path, uint64_t offset, size_t length) {
+    uint64_t total = file_size(path);
+    if (offset > total) throw std::runtime_error("offset past the end of " + path);
+    if (length == 0 || length > total - offset) length = static_cast<size_t>(total - offset);
+    if (length == 0) return;
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot open " + path);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) throw std::runtime_error("cannot map " + path);
+
+    // Views start at a multiple of the allocation granularity
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uint64_t start = offset - offset % info.dwAllocationGranularity;
+    mapped_ = static_cast<size_t>(offset - start) + length;
+    base_ = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(start >> 32), static_cast<DWORD>(start), mapped_);
+    CloseHandle(mapping);
+    if (!base_) throw std::runtime_error("cannot map " + path);
+    data_ = static_cast<const unsigned char*>(base_) + (offset - start);
+    size_ = length;
+}
+
+void MappedFile::unmap() {
+    if (base_) UnmapViewOfFile(base_);
+    base_ = nullptr;
+    data_ = nullptr;
+    size_ = mapped_ = 0;
+}
+
+#else
+
+uint64_t MappedFile::file_size(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) throw std::runtime_error("cannot stat " + path);
+    return static_cast<uint64_t>(info.st_size);
+}
+
+void MappedFile::map(const std::string& path, uint64_t offset, size_t length) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("cannot open " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("cannot stat " + path);
+    }
+    uint64_t total = static_cast<uint64_t>(info.st_size);
+    if (offset > total) {
+        close(fd);
+        throw std::runtime_error("offset past the end of " + path);
+    }
+    if (length == 0 || length > total - offset) length = static_cast<size_t>(total - offset);
+    if (length == 0) {
+        close(fd);
+        return;
+    }
+
+    // Mappings start at a multiple of the page size
+    uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t start = offset - offset % page;
+    mapped_ = static_cast<size_t>(offset - start) + length;
+    void* base = mmap(nullptr, mapped_, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(start));
+    close(fd);
+    if (base == MAP_FAILED) {
+        mapped_ = 0;
+        throw std::runtime_error("cannot map " + path);
+    }
+    // The kernels scan front to back, so ask for aggressive read-ahead
+    madvise(base, mapped_, MADV_SEQUENTIAL);
+    base_ = base;
+    data_ = static_cast<const unsigned char*>(base_) + (offset - start);
+    size_ = length;
+}
+
+void MappedFile::unmap() {
+    if (base_) munmap(base_, mapped_);
+    base_ = nullptr;
+    data_ = nullptr;
+    size_ = mapped_ = 0;
+}
+
+#endif
+
+void writeBinaryFile(const std::string& path, const void* data, size_t bytes) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("cannot create " + path);
+    size_t written = std::fwrite(data, 1, bytes, file);
+    if (std::fclose(file) != 0 || written != bytes) throw std::runtime_error("cannot write " + path);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a file, or of a window of it. The pages are
+// loaded on first access, so spans over a mapping feed kernels without
+// copying and files larger than RAM can be mapped on 64-bit systems.
+// Opening or mapping failures throw std::runtime_error.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    // Map length bytes starting at offset; length 0 maps up to the end of the file
+    MappedFile(const std::string& path, uint64_t offset, size_t length);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // The mapped bytes from offset on as elements of T; a trailing partial element is ignored
+    template <typename T>
+    std::span<const T> elements(size_t offset = 0) const {
+        if (offset >= size_) return {};
+        return { reinterpret_cast<const T*>(data_ + offset), (size_ - offset) / sizeof(T) };
+    }
+
+    static uint64_t file_size(const std::string& path);
+
+private:
+    void map(const std::string& path, uint64_t offset, size_t length);
+    void unmap();
+
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    void* base_ = nullptr;    // start of the mapping, aligned down from data_
+    size_t mapped_ = 0;       // length of the mapping from base_
+};
+
+// Call consume(std::span<const T>) for consecutive chunks of at most
+// chunk_elements elements of a binary file, mapping one window at a time so
+// resident memory stays near one chunk whatever the file size.
+template <typename T, typename Consume>
+void streamFileChunks(const std::string& path, size_t chunk_elements, Consume consume) {
+    uint64_t total = MappedFile::file_size(path) / sizeof(T);
+    for (uint64_t first = 0; first < total; first += chunk_elements) {
+        size_t count = static_cast<size_t>(total - first < chunk_elements ? total - first : chunk_elements);
+        MappedFile window(path, first * sizeof(T), count * sizeof(T));
+        consume(window.elements<T>());
+    }
+}
+
+// Write the elements as a raw binary file, the format streamFileChunks and
+// MappedFile::elements read
+void writeBinaryFile(const std::string& path, const void* data, size_t bytes);
+
+template <typename T>
+void writeSequenceFile(const std::string& path, std::span<const T> values) {
+    writeBinaryFile(path, values.data(), values.size_bytes());
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+// Modulus of the modular kernels unless a caller chooses another prime
+const uint32_t DEFAULT_MODULUS = 1000000007;
+
+// Montgomery arithmetic modulo an odd modulus below 2^31. Values in
+// Montgomery form are x * 2^32 mod p; a product then needs one REDC
+// (two multiplications and a shift) instead of a 64-bit division.
+class Montgomery32 {
+public:
+    explicit Montgomery32(uint32_t modulus) : mod_(modulus) {
+        // Newton iteration for p^-1 mod 2^32, each step doubles the correct bits
+        uint32_t inverse = modulus;
+        for (int i = 0; i < 4; ++i) {
+            inverse *= 2 - modulus * inverse;
+        }
+        neg_inv_ = 0 - inverse;
+        uint64_t r = (uint64_t(1) << 32) % modulus;
+        r2_ = static_cast<uint32_t>(r * r % modulus);
+    }
+
+    uint32_t modulus() const { return mod_; }
+
+    // x * 2^-32 mod p for x < p * 2^32
+    uint32_t reduce(uint64_t x) const {
+        uint32_t m = static_cast<uint32_t>(x) * neg_inv_;
+        uint32_t t = static_cast<uint32_t>((x + static_cast<uint64_t>(m) * mod_) >> 32);
+        return t >= mod_ ? t - mod_ : t;
+    }
+
+    uint32_t to_montgomery(uint32_t x) const { return reduce(static_cast<uint64_t>(x % mod_) * r2_); }
+    uint32_t from_montgomery(uint32_t x) const { return reduce(x); }
+
+    uint32_t multiply(uint32_t a, uint32_t b) const { return reduce(static_cast<uint64_t>(a) * b); }
+
+    uint32_t add(uint32_t a, uint32_t b) const {
+        uint32_t sum = a + b;
+        return sum >= mod_ ? sum - mod_ : sum;
+    }
+
+    uint32_t subtract(uint32_t a, uint32_t b) const {
+        return a >= b ? a - b : a + mod_ - b;
+    }
+
+    // base^exponent, both in and out in Montgomery form
+    uint32_t power(uint32_t base, uint64_t exponent) const {
+        uint32_t result = to_montgomery(1);
+        while (exponent) {
+            if (exponent & 1) result = multiply(result, base);
+            base = multiply(base, base);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+private:
+    uint32_t mod_;
+    uint32_t neg_inv_;  // -p^-1 mod 2^32
+    uint32_t r2_;       // 2^64 mod p
+};
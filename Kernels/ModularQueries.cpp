@@ -0,0 +1,135 @@
+#include "ModularQueries.h"
+
+#include <algorithm>
+#include <bit>
+
+// Largest n answered from a tabulated F mod p (64 MB of residues)
+static const unsigned long long MAX_TABLE_N = 1ull << 24;
+// Larger indices are split into 8-bit digits, each a jump looked up in a shared table
+static const int DIGIT_BITS = 8;
+static const int DIGIT_COUNT = 64 / DIGIT_BITS;
+static const int DIGIT_VALUES = 1 << DIGIT_BITS;
+
+// F(n) and F(n+1) in Montgomery form
+static std::pair<uint32_t, uint32_t> fibonacci_pair_mod(unsigned long long n, const Montgomery32& mont) {
+    uint32_t a = 0, b = mont.to_montgomery(1);  // F(k), F(k+1)
+    for (int bit = 63 - std::countl_zero(n); bit >= 0; --bit) {
+        uint32_t c = mont.multiply(a, mont.subtract(mont.add(b, b), a));  // F(2k)
+        uint32_t d = mont.add(mont.multiply(a, a), mont.multiply(b, b));  // F(2k+1)
+        if ((n >> bit) & 1) {
+            a = d;
+            b = mont.add(c, d);
+        }
+        else {
+            a = c;
+            b = d;
+        }
+    }
+    return { a, b };
+}
+
+// F(x + y), F(x + y + 1) from the pairs of x and y, all in Montgomery form
+static std::pair<uint32_t, uint32_t> add_indices(std::pair<uint32_t, uint32_t> x, std::pair<uint32_t, uint32_t> y,
+    const Montgomery32& mont) {
+    uint32_t low = mont.multiply(x.first, y.first);
+    uint32_t sum = mont.subtract(mont.add(mont.multiply(x.first, y.second), mont.multiply(x.second, y.first)), low);
+    uint32_t next = mont.add(mont.multiply(x.second, y.second), low);
+    return { sum, next };
+}
+
+uint32_t fibonacci_mod(unsigned long long n, uint32_t p) {
+    Montgomery32 mont(p);
+    return mont.from_montgomery(fibonacci_pair_mod(n, mont).first);
+}
+
+std::vector<uint32_t> fibonacci_mod_batch(const std::vector<unsigned long long>& queries, uint32_t p) {
+    std::vector<uint32_t> answers(queries.size());
+    if (queries.empty()) return answers;
+    unsigned long long max_n = *std::max_element(queries.begin(), queries.end());
+
+    // Tabulate when the table is no bigger than a few entries per query
+    if (max_n <= MAX_TABLE_N && max_n <= 4 * queries.size() + 65536) {
+        std::vector<uint32_t> table(max_n + 2);
+        table[0] = 0;
+        table[1] = 1 % p;
+        for (unsigned long long i = 2; i <= max_n; ++i) {
+            uint32_t sum = table[i - 1] + table[i - 2];
+            table[i] = sum >= p ? sum - p : sum;
+        }
+        for (size_t i = 0; i < queries.size(); ++i) {
+            answers[i] = table[queries[i]];
+        }
+        return answers;
+    }
+
+    // Huge indices: jumps[d][v] holds F(v * 256^d) and F(v * 256^d + 1), and
+    // F(x + y) follows from the pairs of x and y with four multiplications
+    Montgomery32 mont(p);
+    std::vector<std::pair<uint32_t, uint32_t>> jumps(DIGIT_COUNT * DIGIT_VALUES);
+    for (int digit = 0; digit < DIGIT_COUNT; ++digit) {
+        auto* row = &jumps[digit * DIGIT_VALUES];
+        row[0] = { 0, mont.to_montgomery(1) };
+        row[1] = fibonacci_pair_mod(1ull << (digit * DIGIT_BITS), mont);
+        for (int value = 2; value < DIGIT_VALUES; ++value) {
+            row[value] = add_indices(row[value - 1], row[1], mont);
+        }
+    }
+    for (size_t i = 0; i < queries.size(); ++i) {
+        unsigned long long n = queries[i];
+        std::pair<uint32_t, uint32_t> result = jumps[n & (DIGIT_VALUES - 1)];
+        n >>= DIGIT_BITS;
+        for (int digit = 1; n; ++digit, n >>= DIGIT_BITS) {
+            if (n & (DIGIT_VALUES - 1)) {
+                result = add_indices(result, jumps[digit * DIGIT_VALUES + (n & (DIGIT_VALUES - 1))], mont);
+            }
+        }
+        answers[i] = mont.from_montgomery(result.first);
+    }
+    return answers;
+}
+
+BinomialTable::BinomialTable(int max_n, uint32_t p)
+    : mont_(p), factorial_(max_n + 1), inverse_factorial_(max_n + 1) {
+    uint32_t one = mont_.to_montgomery(1);
+    uint32_t i_mont = 0;  // i in Montgomery form, advanced by addition instead of conversion
+    factorial_[0] = 1 % p;
+    for (int i = 1; i <= max_n; ++i) {
+        i_mont = mont_.add(i_mont, one);
+        factorial_[i] = mont_.multiply(factorial_[i - 1], i_mont);
+    }
+
+    // One exponentiation (Fermat) for the largest inverse, the rest walk back down
+    inverse_factorial_[max_n] = mont_.power(mont_.to_montgomery(factorial_[max_n]), p - 2);
+    for (int i = max_n; i > 0; --i) {
+        inverse_factorial_[i - 1] = mont_.multiply(inverse_factorial_[i], i_mont);
+        i_mont = mont_.subtract(i_mont, one);
+    }
+}
+
+uint32_t countPathsMod(int m, int n, uint32_t p) {
+    if (m <= 0 || n <= 0) return 0;
+    // C(m + n - 2, k) with k the shorter side, as one product over one inverse
+    int k = std::min(m, n) - 1;
+    int top = m + n - 2;
+    Montgomery32 mont(p);
+    uint32_t numerator = mont.to_montgomery(1), denominator = numerator;
+    for (int i = 1; i <= k; ++i) {
+        numerator = mont.multiply(numerator, mont.to_montgomery(top - k + i));
+        denominator = mont.multiply(denominator, mont.to_montgomery(i));
+    }
+    return mont.from_montgomery(mont.multiply(numerator, mont.power(denominator, p - 2)));
+}
+
+std::vector<uint32_t> countPathsModBatch(const std::vector<std::pair<int, int>>& grids, uint32_t p) {
+    std::vector<uint32_t> answers(grids.size());
+    int max_top = 0;
+    for (const auto& [m, n] : grids) {
+        max_top = std::max(max_top, m + n - 2);
+    }
+    BinomialTable table(max_top, p);
+    for (size_t i = 0; i < grids.size(); ++i) {
+        auto [m, n] = grids[i];
+        answers[i] = (m <= 0 || n <= 0) ? 0 : table.binomial(m + n - 2, m - 1);
+    }
+    return answers;
+}
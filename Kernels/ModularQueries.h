@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ModularArithmetic.h"
+
+// F(n) mod p by fast doubling in Montgomery form; p must be odd and below 2^31
+uint32_t fibonacci_mod(unsigned long long n, uint32_t p = DEFAULT_MODULUS);
+
+// F(n) mod p for every query. Small maximum n builds one table of F mod p and
+// gathers from it; otherwise each n is assembled from precomputed jumps, one
+// per non-zero byte of n.
+std::vector<uint32_t> fibonacci_mod_batch(const std::vector<unsigned long long>& queries, uint32_t p = DEFAULT_MODULUS);
+
+// Factorials and inverse factorials mod a prime p, for binomials C(n, k) with n < p
+class BinomialTable {
+public:
+    BinomialTable(int max_n, uint32_t p = DEFAULT_MODULUS);
+
+    int max_n() const { return static_cast<int>(factorial_.size()) - 1; }
+
+    // C(n, k) mod p for 0 <= k <= n <= max_n()
+    uint32_t binomial(int n, int k) const {
+        return mont_.multiply(mont_.multiply(factorial_[n], inverse_factorial_[k]), inverse_factorial_[n - k]);
+    }
+
+private:
+    Montgomery32 mont_;
+    std::vector<uint32_t> factorial_;          // plain residues
+    std::vector<uint32_t> inverse_factorial_;  // Montgomery form, so two REDCs give a plain result
+};
+
+// Paths in an m x n grid mod p, i.e. C(m + n - 2, m - 1) mod p; p must be a prime above m + n
+uint32_t countPathsMod(int m, int n, uint32_t p = DEFAULT_MODULUS);
+
+// countPathsMod for every (m, n) query, sharing one factorial table
+std::vector<uint32_t> countPathsModBatch(const std::vector<std::pair<int, int>>& grids, uint32_t p = DEFAULT_MODULUS);
@@ -0,0 +1,212 @@
+#include "PathCounting.h"
+
+#include <stack>
+#include <array>
+#include <algorithm>
+
+#include "CpuFeatures.h"
+
+#if defined(DP_X86)
+#include <immintrin.h>
+#endif
+
+// Function to count paths using brute force
+int countPathsBruteForce(int m, int n) {
+    std::stack<Position> stk;
+    stk.push({ 0, 0, 1 });
+    int totalPaths = 0;
+
+    while (!stk.empty()) {
+        Position pos = stk.top();
+        stk.pop();
+
+        int i = pos.i, j = pos.j, pathCount = pos.pathCount;
+
+        // If we reach the bottom-right corner, add to total paths
+        if (i == m - 1 && j == n - 1) {
+            totalPaths += pathCount;
+            continue;
+        }
+
+        // Move right if within bounds
+        if (j + 1 < n) {
+            stk.push({ i, j + 1, pathCount });
+        }
+
+        // Move down if within bounds
+        if (i + 1 < m) {
+            stk.push({ i + 1, j, pathCount });
+        }
+    }
+
+    return totalPaths;
+}
+
+// Function to count paths using dynamic programming with memoization
+int countPathsMemoization(int m, int n, std::vector<std::vector<int>>& dp) {
+    if (m == 1 || n == 1) return 1;  // Base case
+    if (dp[m - 1][n - 1] != -1) return dp[m - 1][n - 1];  // Return memoized result
+    dp[m - 1][n - 1] = countPathsMemoization(m - 1, n, dp) + countPathsMemoization(m, n - 1, dp);  // Memoize result
+    return dp[m - 1][n - 1];
+}
+
+int countPathsMemoizationWrapper(int m, int n) {
+    std::vector<std::vector<int>> dp(m, std::vector<int>(n, -1));
+    return countPathsMemoization(m, n, dp);
+}
+
+// Function to count paths using dynamic programming with tabulation
+int countPathsTabulation(int m, int n) {
+    std::array<std::array<int, MAX_SIZE>, MAX_SIZE> dp = {};
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i == 0 || j == 0) {
+                dp[i][j] = 1;
+            }
+            else {
+                dp[i][j] = dp[i - 1][j] + dp[i][j - 1];
+            }
+        }
+    }
+
+    return dp[m - 1][n - 1];
+}
+
+// Function to count paths keeping one row of min(m, n) counts
+int countPathsRollingRow(int m, int n) {
+    if (m <= 0 || n <= 0) return 0;
+    // Unsigned counts wrap instead of overflowing
+    std::vector<unsigned> row(std::min(m, n), 1);
+    for (int i = 1; i < std::max(m, n); ++i) {
+        for (size_t j = 1; j < row.size(); ++j) {
+            row[j] += row[j - 1];
+        }
+    }
+    return static_cast<int>(row.back());
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+// (a + b) mod p per lane for a, b < p < 2^31: a + b - p is negative exactly
+// when p has to be added back, and the sign mask selects it
+static inline __m128i add_mod(__m128i a, __m128i b, __m128i mod) {
+    __m128i t = _mm_sub_epi32(_mm_add_epi32(a, b), mod);
+    return _mm_add_epi32(t, _mm_and_si128(mod, _mm_srai_epi32(t, 31)));
+}
+#endif
+
+#if defined(DP_X86)
+DP_TARGET_AVX2 static inline __m256i add_mod(__m256i a, __m256i b, __m256i mod) {
+    __m256i t = _mm256_sub_epi32(_mm256_add_epi32(a, b), mod);
+    return _mm256_add_epi32(t, _mm256_and_si256(mod, _mm256_srai_epi32(t, 31)));
+}
+#endif
+
+// Continue the prefix sums mod p from row[j] on, one element at a time
+static void prefixSumModTail(uint32_t* row, size_t j, size_t count, uint32_t running, uint32_t p) {
+    for (; j < count; ++j) {
+        uint32_t sum = running + row[j];
+        running = sum >= p ? sum - p : sum;
+        row[j] = running;
+    }
+}
+
+// Replace row with its prefix sums mod p. Each block of lanes is summed with
+// log2(lanes) shifted adds, then offset by the running total of earlier blocks.
+static void prefixSumMod(uint32_t* row, size_t count, uint32_t p) {
+    size_t j = 0;
+    uint32_t running = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i mod4 = _mm_set1_epi32(static_cast<int>(p));
+    __m128i carry4 = _mm_setzero_si128();
+    for (; j + 4 <= count; j += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + j));
+        x = add_mod(x, _mm_slli_si128(x, 4), mod4);
+        x = add_mod(x, _mm_slli_si128(x, 8), mod4);
+        x = add_mod(x, carry4, mod4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + j), x);
+        carry4 = _mm_shuffle_epi32(x, 0xFF);
+    }
+    running = static_cast<uint32_t>(_mm_cvtsi128_si32(carry4));
+#endif
+    prefixSumModTail(row, j, count, running, p);
+}
+
+#if defined(DP_X86)
+DP_TARGET_AVX2 static void prefixSumModAvx2(uint32_t* row, size_t count, uint32_t p) {
+    size_t j = 0;
+    const __m256i mod8 = _mm256_set1_epi32(static_cast<int>(p));
+    const __m256i last_of_low_half = _mm256_set1_epi32(3);
+    const __m256i last_lane = _mm256_set1_epi32(7);
+    __m256i carry8 = _mm256_setzero_si256();
+    for (; j + 8 <= count; j += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j));
+        x = add_mod(x, _mm256_slli_si256(x, 4), mod8);  // shifts stay within 128-bit halves
+        x = add_mod(x, _mm256_slli_si256(x, 8), mod8);
+        __m256i low_total = _mm256_permutevar8x32_epi32(x, last_of_low_half);
+        x = add_mod(x, _mm256_blend_epi32(_mm256_setzero_si256(), low_total, 0xF0), mod8);
+        x = add_mod(x, carry8, mod8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + j), x);
+        carry8 = _mm256_permutevar8x32_epi32(x, last_lane);
+    }
+    prefixSumModTail(row, j, count, static_cast<uint32_t>(_mm256_cvtsi256_si32(carry8)), p);
+}
+#endif
+
+// Function to count paths mod p keeping one row of min(m, n) counts
+uint32_t countPathsRollingRowMod(int m, int n, uint32_t p, SimdLevel level) {
+    if (m <= 0 || n <= 0) return 0;
+    auto rowPrefixSum = prefixSumMod;
+#if defined(DP_X86)
+    if (supportedSimdLevel(level) >= SimdLevel::Avx2) rowPrefixSum = prefixSumModAvx2;
+#endif
+    std::vector<uint32_t> row(std::min(m, n), 1 % p);
+    for (int i = 1; i < std::max(m, n); ++i) {
+        rowPrefixSum(row.data(), row.size(), p);
+    }
+    return row.back();
+}
+
+// Function to count paths exactly in closed form. By Legendre's formula the
+// exponent of each prime q in C(N, k) is the sum over powers q^i of
+// N/q^i - k/q^i - (N-k)/q^i; the prime powers are packed into 64-bit words
+// and multiplied pairwise so the large products stay balanced for Karatsuba.
+BigUnsigned countPathsBinomial(int m, int n) {
+    if (m <= 0 || n <= 0) return 0;
+    long long total = static_cast<long long>(m) + n - 2;
+    long long k = std::min(m, n) - 1;
+
+    std::vector<bool> composite(total + 1, false);
+    std::vector<BigUnsigned> factors;
+    uint64_t word = 1;
+    for (long long q = 2; q <= total; ++q) {
+        if (composite[q]) continue;
+        for (long long multiple = q * q; multiple <= total; multiple += q) {
+            composite[multiple] = true;
+        }
+
+        int exponent = 0;
+        for (long long power = q; power <= total; power *= q) {
+            exponent += static_cast<int>(total / power - k / power - (total - k) / power);
+            if (power > total / q) break;
+        }
+        for (int e = 0; e < exponent; ++e) {
+            if (word > UINT64_MAX / static_cast<uint64_t>(q)) {
+                factors.push_back(word);
+                word = 1;
+            }
+            word *= static_cast<uint64_t>(q);
+        }
+    }
+    factors.push_back(word);
+
+    while (factors.size() > 1) {
+        std::vector<BigUnsigned> products;
+        for (size_t i = 0; i + 1 < factors.size(); i += 2) {
+            products.push_back(factors[i] * factors[i + 1]);
+        }
+        if (factors.size() % 2) products.push_back(std::move(factors.back()));
+        factors = std::move(products);
+    }
+    return factors[0];
+}
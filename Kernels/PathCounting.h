@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BigUnsigned.h"
+#include "CpuFeatures.h"
+#include "ModularArithmetic.h"
+
+const int MAX_SIZE = 100;
+
+// Structure to represent a position in the matrix
+struct Position {
+    int i, j;
+    int pathCount;
+};
+
+// Function to count paths using brute force
+int countPathsBruteForce(int m, int n);
+
+// Function to count paths using dynamic programming with memoization
+int countPathsMemoization(int m, int n, std::vector<std::vector<int>>& dp);
+
+int countPathsMemoizationWrapper(int m, int n);
+
+// Function to count paths using dynamic programming with tabulation
+int countPathsTabulation(int m, int n);
+
+// Function to count paths keeping one row of min(m, n) counts; wraps like countPathsTabulation
+int countPathsRollingRow(int m, int n);
+
+// Function to count paths mod p keeping one row of min(m, n) counts, p an odd modulus below 2^31.
+// Each row is the prefix sum of the previous one, computed 4 (SSE2) or 8 (AVX2) lanes at a time;
+// AVX2 is used when the CPU has it and level allows it.
+uint32_t countPathsRollingRowMod(int m, int n, uint32_t p = DEFAULT_MODULUS, SimdLevel level = bestSimdLevel());
+
+// Function to count paths exactly in closed form, C(m + n - 2, m - 1) from its prime factorisation
+BigUnsigned countPathsBinomial(int m, int n);
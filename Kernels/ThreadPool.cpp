@@ -0,0 +1,125 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) : runs_(new ChunkRun[std::max(threads, 1u)]) {
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+static uint64_t packRun(uint64_t front, uint64_t back) {
+    return front << 32 | back;
+}
+
+// Claim the first chunk of this thread's own run
+bool ThreadPool::take_front(unsigned self, size_t& chunk) {
+    std::atomic<uint64_t>& run = runs_[self].chunks;
+    uint64_t current = run.load(std::memory_order_acquire);
+    while (true) {
+        uint64_t front = current >> 32, back = current & 0xFFFFFFFF;
+        if (front >= back) return false;
+        if (run.compare_exchange_weak(current, packRun(front + 1, back), std::memory_order_acq_rel)) {
+            chunk = front;
+            return true;
+        }
+    }
+}
+
+// Take the back half of the first non-empty run after this thread's own. One
+// stolen chunk is returned to run now; the rest becomes this thread's run,
+// which is empty at this point, so no other thread is changing it.
+bool ThreadPool::steal(unsigned self, size_t& chunk) {
+    unsigned threads = size();
+    for (unsigned k = 1; k < threads; ++k) {
+        std::atomic<uint64_t>& run = runs_[(self + k) % threads].chunks;
+        uint64_t current = run.load(std::memory_order_acquire);
+        while (true) {
+            uint64_t front = current >> 32, back = current & 0xFFFFFFFF;
+            if (front >= back) break;
+            uint64_t middle = front + (back - front) / 2;
+            if (run.compare_exchange_weak(current, packRun(front, middle), std::memory_order_acq_rel)) {
+                chunk = middle;
+                runs_[self].chunks.store(packRun(middle + 1, back), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_chunk(size_t chunk) {
+    size_t first = begin_ + chunk * grain_;
+    size_t last = std::min(end_, first + grain_);
+    for (size_t i = first; i < last; ++i) {
+        (*body_)(i);
+    }
+}
+
+// Run chunks of the current loop, own ones first, until no thread has any left
+void ThreadPool::work_on_current(unsigned self) {
+    size_t chunk;
+    while (take_front(self, chunk) || steal(self, chunk)) {
+        run_chunk(chunk);
+    }
+}
+
+void ThreadPool::worker_loop(unsigned self) {
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+        if (stopping_) return;
+        seen = generation_;
+        lock.unlock();
+        work_on_current(self);
+        lock.lock();
+        if (--pending_ == 0) done_.notify_one();
+    }
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, const std::function<void(size_t)>& body, size_t grain) {
+    if (begin >= end) return;
+    if (workers_.empty() || end - begin == 1) {
+        for (size_t i = begin; i < end; ++i) body(i);
+        return;
+    }
+
+    // Chunk numbers have to fit the 32-bit halves of a run
+    unsigned threads = size();
+    size_t count = end - begin;
+    if (grain == 0) grain = std::max<size_t>(1, count / (16 * size_t(threads)));
+    grain = std::max(grain, count / 0xFFFFFFFF + 1);
+    size_t chunks = (count + grain - 1) / grain;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        begin_ = begin;
+        end_ = end;
+        grain_ = grain;
+        for (unsigned t = 0; t < threads; ++t) {
+            runs_[t].chunks.store(packRun(chunks * t / threads, chunks * (t + 1) / threads), std::memory_order_relaxed);
+        }
+        pending_ = static_cast<unsigned>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+    work_on_current(0);
+
+    // Every worker checks in once per loop, so none can still be reading this
+    // loop's state when the next one starts
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. parallel_for splits the
+// index range into chunks and deals each thread (the caller included) an equal
+// run of them. A thread takes chunks from the front of its own run and, once it
+// is empty, steals the back half of another thread's run, so uneven work
+// (sequences of different lengths, say) still keeps every thread busy. A pool
+// of size 1 runs everything on the caller without extra threads.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads working on a loop, including the caller
+    unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+    // Run body(i) for every i in [begin, end) and return when all calls are done.
+    // grain indices form one chunk; 0 picks about 16 chunks per thread.
+    void parallel_for(size_t begin, size_t end, const std::function<void(size_t)>& body, size_t grain = 0);
+
+private:
+    // Chunks [front, back) still owned by one thread, packed as front << 32 | back
+    // so the owner and thieves update them with one compare-and-swap
+    struct alignas(64) ChunkRun {
+        std::atomic<uint64_t> chunks{ 0 };
+    };
+
+    void worker_loop(unsigned self);
+    void work_on_current(unsigned self);
+    bool take_front(unsigned self, size_t& chunk);
+    bool steal(unsigned self, size_t& chunk);
+    void run_chunk(size_t chunk);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::unique_ptr<ChunkRun[]> runs_;  // one per thread, the caller is 0
+    const std::function<void(size_t)>* body_ = nullptr;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    size_t grain_ = 1;
+    size_t generation_ = 0;
+    unsigned pending_ = 0;  // workers that have not finished the current loop
+    bool stopping_ = false;
+};
@@ -0,0 +1,503 @@
+#include "TwoSum.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring> // Para usar memset
+#include <limits>
+#include <tuple>
+
+#include "CpuFeatures.h"
+
+#if defined(DP_X86)
+#include <immintrin.h>
+#endif
+
+// Brute Force Solution
+std::pair<int, int> ValuesBruteForce(std::span<const int> sequence, int targetSum) {
+    int n = sequence.size();
+    for (int i = 0; i < n - 1; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            if (sequence[i] + sequence[j] == targetSum) {
+                return std::make_pair(sequence[i], sequence[j]);
+            }
+        }
+    }
+    return std::make_pair(-1, -1);
+}
+
+#if defined(DP_X86)
+// For each i, targetSum - sequence[i] is compared with 16 later elements per
+// step; the first set bit of the combined mask is the smallest matching j, so
+// the pair found is the same as the scalar loop's. Sums wrap like the scalar
+// int addition on two's complement machines.
+DP_TARGET_AVX2 static std::pair<int, int> bruteForceAvx2(std::span<const int> sequence, int targetSum) {
+    const int* values = sequence.data();
+    size_t n = sequence.size();
+    for (size_t i = 0; i + 1 < n; ++i) {
+        int complement = static_cast<int>(static_cast<unsigned>(targetSum) - static_cast<unsigned>(values[i]));
+        __m256i wanted = _mm256_set1_epi32(complement);
+        size_t j = i + 1;
+        for (; j + 16 <= n; j += 16) {
+            __m256i hit0 = _mm256_cmpeq_epi32(wanted, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j)));
+            __m256i hit1 = _mm256_cmpeq_epi32(wanted, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j + 8)));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit0)))
+                | static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit1))) << 8;
+            if (mask) return std::make_pair(values[i], values[j + std::countr_zero(mask)]);
+        }
+        for (; j < n; ++j) {
+            if (values[j] == complement) return std::make_pair(values[i], values[j]);
+        }
+    }
+    return std::make_pair(-1, -1);
+}
+
+DP_TARGET_AVX512 static std::pair<int, int> bruteForceAvx512(std::span<const int> sequence, int targetSum) {
+    const int* values = sequence.data();
+    size_t n = sequence.size();
+    for (size_t i = 0; i + 1 < n; ++i) {
+        int complement = static_cast<int>(static_cast<unsigned>(targetSum) - static_cast<unsigned>(values[i]));
+        __m512i wanted = _mm512_set1_epi32(complement);
+        size_t j = i + 1;
+        for (; j + 32 <= n; j += 32) {
+            uint32_t mask = static_cast<uint32_t>(_mm512_cmpeq_epi32_mask(wanted, _mm512_loadu_si512(values + j)))
+                | static_cast<uint32_t>(_mm512_cmpeq_epi32_mask(wanted, _mm512_loadu_si512(values + j + 16))) << 16;
+            if (mask) return std::make_pair(values[i], values[j + std::countr_zero(mask)]);
+        }
+        // The last 0-31 elements through masked loads, which never read past the end
+        for (; j < n; j += 16) {
+            __mmask16 valid = static_cast<__mmask16>(n - j >= 16 ? 0xFFFF : (1u << (n - j)) - 1);
+            uint32_t mask = _mm512_mask_cmpeq_epi32_mask(valid, wanted, _mm512_maskz_loadu_epi32(valid, values + j));
+            if (mask) return std::make_pair(values[i], values[j + std::countr_zero(mask)]);
+        }
+    }
+    return std::make_pair(-1, -1);
+}
+#endif
+
+std::pair<int, int> ValuesBruteForceSimd(std::span<const int> sequence, int targetSum, SimdLevel level) {
+    switch (supportedSimdLevel(level)) {
+#if defined(DP_X86)
+    case SimdLevel::Avx512: return bruteForceAvx512(sequence, targetSum);
+    case SimdLevel::Avx2: return bruteForceAvx2(sequence, targetSum);
+#endif
+    default: return ValuesBruteForce(sequence, targetSum);
+    }
+}
+
+// Naive Recursive Solution
+std::optional<std::pair<int, int>> findPairRecursively(const std::vector<int>& arr, int target, int start, int end) {
+    if (start >= end) {
+        return std::nullopt;
+    }
+    if (arr[start] + arr[end] == target) {
+        return std::make_optional(std::make_pair(arr[start], arr[end]));
+    }
+    auto result = findPairRecursively(arr, target, start + 1, end);
+    if (result) {
+        return result;
+    }
+    return findPairRecursively(arr, target, start, end - 1);
+}
+
+std::optional<std::pair<int, int>> ValuesRecursive(const std::vector<int>& sequence, int targetSum) {
+    return findPairRecursively(sequence, targetSum, 0, sequence.size() - 1);
+}
+
+// Memoized Recursive Solution
+std::string createKey(int start, int end) {
+    return std::to_string(start) + "," + std::to_string(end);
+}
+
+std::optional<std::pair<int, int>> findPairRecursivelyMemo(
+    const std::vector<int>& arr, int target, int start, int end,
+    std::unordered_map<std::string, std::optional<std::pair<int, int>>>& memo) {
+    if (start >= end) {
+        return std::nullopt;
+    }
+    std::string key = createKey(start, end);
+    if (memo.find(key) != memo.end()) {
+        return memo[key];
+    }
+    if (arr[start] + arr[end] == target) {
+        auto result = std::make_optional(std::make_pair(arr[start], arr[end]));
+        memo[key] = result;
+        return result;
+    }
+    auto result = findPairRecursivelyMemo(arr, target, start + 1, end, memo);
+    if (result) {
+        memo[key] = result;
+        return result;
+    }
+    result = findPairRecursivelyMemo(arr, target, start, end - 1, memo);
+    memo[key] = result;
+    return result;
+}
+
+std::optional<std::pair<int, int>> ValuesMemoizedStringKeys(const std::vector<int>& sequence, int targetSum) {
+    std::unordered_map<std::string, std::optional<std::pair<int, int>>> memo;
+    return findPairRecursivelyMemo(sequence, targetSum, 0, sequence.size() - 1, memo);
+}
+
+std::optional<std::pair<int, int>> ValuesMemoizedPacked(const std::vector<int>& sequence, int targetSum) {
+    thread_local PackedPairMemo memo;
+    memo.reset();
+    return findPairRecursivelyMemo(sequence, targetSum, 0, static_cast<int>(sequence.size()) - 1, memo);
+}
+
+std::optional<std::pair<int, int>> ValuesMemoizedTriangle(const std::vector<int>& sequence, int targetSum) {
+    thread_local TrianglePairMemo memo;
+    memo.reset(sequence.size());
+    return findPairRecursivelyMemo(sequence, targetSum, 0, static_cast<int>(sequence.size()) - 1, memo);
+}
+
+std::optional<std::pair<int, int>> ValuesMemoized(const std::vector<int>& sequence, int targetSum) {
+    if (sequence.size() <= MEMO_TRIANGLE_MAX_N) return ValuesMemoizedTriangle(sequence, targetSum);
+    return ValuesMemoizedPacked(sequence, targetSum);
+}
+
+// Tabulation Solution
+template <typename T>
+static std::optional<std::pair<T, T>> tabulationPair(std::span<const T> sequence, T targetSum) {
+    // size_t indices keep multi-GB mapped inputs in range
+    std::unordered_map<T, size_t> table;
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        T complement = targetSum - sequence[i];
+        if (table.find(complement) != table.end()) {
+            return std::make_optional(std::make_pair(sequence[i], complement));
+        }
+        table[sequence[i]] = i;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::pair<int, int>> ValuesTabulation(std::span<const int> sequence, int targetSum) {
+    return tabulationPair(sequence, targetSum);
+}
+
+std::optional<std::pair<int64_t, int64_t>> ValuesTabulation(std::span<const int64_t> sequence, int64_t targetSum) {
+    return tabulationPair(sequence, targetSum);
+}
+
+// Tabulation Solution on an open-addressing table. One table per thread is kept
+// between calls: clearing it is O(1) and it only grows, so repeated calls on
+// inputs of similar size neither allocate nor touch the whole table.
+template <typename T>
+static std::optional<std::pair<T, T>> tabulationPairFlat(std::span<const T> sequence, T targetSum) {
+    thread_local FlatHashSet<T> table;
+    table.clear();
+    table.reserve(sequence.size());
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        T complement = targetSum - sequence[i];
+        if (table.contains(complement)) {
+            return std::make_optional(std::make_pair(sequence[i], complement));
+        }
+        table.insert(sequence[i]);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::pair<int, int>> ValuesTabulationFlat(std::span<const int> sequence, int targetSum) {
+    return tabulationPairFlat(sequence, targetSum);
+}
+
+std::optional<std::pair<int64_t, int64_t>> ValuesTabulationFlat(std::span<const int64_t> sequence, int64_t targetSum) {
+    return tabulationPairFlat(sequence, targetSum);
+}
+
+static std::pair<int, int> minMaxScalar(std::span<const int> sequence) {
+    int low = std::numeric_limits<int>::max(), high = std::numeric_limits<int>::min();
+    for (int value : sequence) {
+        low = std::min(low, value);
+        high = std::max(high, value);
+    }
+    return { low, high };
+}
+
+#if defined(DP_X86)
+DP_TARGET_AVX2 static std::pair<int, int> minMaxAvx2(std::span<const int> sequence) {
+    const int* values = sequence.data();
+    size_t n = sequence.size(), i = 0;
+    __m256i low0 = _mm256_set1_epi32(std::numeric_limits<int>::max()), low1 = low0;
+    __m256i high0 = _mm256_set1_epi32(std::numeric_limits<int>::min()), high1 = high0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 8));
+        low0 = _mm256_min_epi32(low0, a);
+        low1 = _mm256_min_epi32(low1, b);
+        high0 = _mm256_max_epi32(high0, a);
+        high1 = _mm256_max_epi32(high1, b);
+    }
+    __m256i low = _mm256_min_epi32(low0, low1), high = _mm256_max_epi32(high0, high1);
+    __m128i low4 = _mm_min_epi32(_mm256_castsi256_si128(low), _mm256_extracti128_si256(low, 1));
+    __m128i high4 = _mm_max_epi32(_mm256_castsi256_si128(high), _mm256_extracti128_si256(high, 1));
+    low4 = _mm_min_epi32(low4, _mm_shuffle_epi32(low4, 0x4E));
+    low4 = _mm_min_epi32(low4, _mm_shuffle_epi32(low4, 0xB1));
+    high4 = _mm_max_epi32(high4, _mm_shuffle_epi32(high4, 0x4E));
+    high4 = _mm_max_epi32(high4, _mm_shuffle_epi32(high4, 0xB1));
+    std::pair<int, int> tail = minMaxScalar(sequence.subspan(i));
+    return { std::min(_mm_cvtsi128_si32(low4), tail.first), std::max(_mm_cvtsi128_si32(high4), tail.second) };
+}
+#endif
+
+std::pair<int, int> minMaxValues(std::span<const int> sequence) {
+#if defined(DP_X86)
+    if (bestSimdLevel() >= SimdLevel::Avx2) return minMaxAvx2(sequence);
+#endif
+    return minMaxScalar(sequence);
+}
+
+// Tabulation Solution on a direct-address table over [min, max]. Slot v - min
+// holds the generation of the call that last saw v, so the table, kept per
+// thread, never has to be cleared between calls.
+std::optional<std::pair<int, int>> ValuesTabulationDirect(std::span<const int> sequence, int targetSum) {
+    if (sequence.size() < 2) return std::nullopt;
+    auto [low, high] = minMaxValues(sequence);
+    int64_t range = int64_t(high) - low + 1;
+    if (range > std::max<int64_t>(DIRECT_TABLE_MIN_RANGE, DIRECT_TABLE_SPREAD * int64_t(sequence.size()))) {
+        return ValuesTabulationFlat(sequence, targetSum);
+    }
+
+    thread_local std::vector<uint32_t> seen;
+    thread_local uint32_t generation = 0;
+    if (seen.size() < size_t(range)) seen.resize(range, 0);
+    if (++generation == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        generation = 1;
+    }
+    for (int value : sequence) {
+        // The complement is computed in 64 bits, so no target can overflow it
+        int64_t complement = int64_t(targetSum) - value;
+        if (complement >= low && complement <= high && seen[complement - low] == generation) {
+            return std::make_pair(value, static_cast<int>(complement));
+        }
+        seen[value - low] = generation;
+    }
+    return std::nullopt;
+}
+
+// Stable LSD radix sort of entries by their high 32 bits, 11 bits per pass.
+// All three histograms come from one read of the input, and a pass is skipped
+// when every key has the same digit, as for small or narrow value ranges.
+static void radixSortHigh32(std::vector<uint64_t>& entries, std::vector<uint64_t>& buffer) {
+    const int digitBits = 11, digits = 1 << digitBits, passes = 3;
+    std::vector<size_t> counts(passes * digits, 0);
+    for (uint64_t entry : entries) {
+        uint32_t key = static_cast<uint32_t>(entry >> 32);
+        for (int pass = 0; pass < passes; ++pass) {
+            ++counts[pass * digits + ((key >> (pass * digitBits)) & (digits - 1))];
+        }
+    }
+    buffer.resize(entries.size());
+    for (int pass = 0; pass < passes; ++pass) {
+        size_t* count = &counts[pass * digits];
+        int shift = 32 + pass * digitBits;
+        if (count[(entries[0] >> shift) & (digits - 1)] == entries.size()) continue;
+        size_t offset = 0;
+        for (int d = 0; d < digits; ++d) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (uint64_t entry : entries) {
+            buffer[count[(entry >> shift) & (digits - 1)]++] = entry;
+        }
+        entries.swap(buffer);
+    }
+}
+
+// Sort and Two-Pointer Solution: the positions sortedPairPositions finds in the
+// sorted values, mapped back to the original indices. The sorted values and
+// their indices are kept per thread between calls.
+std::optional<std::pair<size_t, size_t>> IndicesSortTwoPointer(std::span<const int> sequence, int targetSum) {
+    thread_local std::vector<int> values;
+    thread_local std::vector<size_t> indices;
+    sortWithIndices(sequence, values, indices);
+    auto pair = sortedPairPositions(values, targetSum);
+    if (!pair) return std::nullopt;
+    return std::minmax(indices[pair->first], indices[pair->second]);
+}
+
+// Each value is packed with its index as (value with the sign bit flipped) << 32
+// | index, so radix-sorting the high half keeps the indices. 16 bytes per element
+// of scratch, kept per thread between calls.
+void sortWithIndices(std::span<const int> sequence, std::vector<int>& values, std::vector<size_t>& indices) {
+    size_t n = sequence.size();
+    values.resize(n);
+    indices.resize(n);
+    if (n > UINT32_MAX) {
+        // Indices no longer fit the low half; sort (value, index) pairs instead
+        std::vector<std::pair<int, size_t>> sorted(n);
+        for (size_t i = 0; i < n; ++i) sorted[i] = { sequence[i], i };
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < n; ++i) std::tie(values[i], indices[i]) = sorted[i];
+        return;
+    }
+
+    thread_local std::vector<uint64_t> entries, buffer;
+    entries.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        entries[i] = uint64_t(static_cast<uint32_t>(sequence[i]) ^ 0x80000000u) << 32 | i;
+    }
+    if (n > 0) radixSortHigh32(entries, buffer);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<int>(static_cast<uint32_t>(entries[i] >> 32) ^ 0x80000000u);
+        indices[i] = static_cast<uint32_t>(entries[i]);
+    }
+}
+
+std::optional<std::pair<size_t, size_t>> sortedPairPositions(std::span<const int> sorted, int64_t targetSum) {
+    if (sorted.size() < 2) return std::nullopt;
+    for (size_t low = 0, high = sorted.size() - 1; low < high;) {
+        int64_t sum = int64_t(sorted[low]) + sorted[high];
+        if (sum == targetSum) return std::make_pair(low, high);
+        if (sum < targetSum) ++low;
+        else --high;
+    }
+    return std::nullopt;
+}
+
+template <typename T>
+std::optional<std::pair<int64_t, int64_t>> TwoSumStream::scan(std::span<const T> chunk) {
+    if (result_) return result_;
+    for (T value : chunk) {
+        int64_t complement = target_ - value;
+        if (seen_.count(complement)) {
+            result_ = std::make_pair(static_cast<int64_t>(value), complement);
+            break;
+        }
+        seen_.insert(value);
+    }
+    return result_;
+}
+
+std::optional<std::pair<int64_t, int64_t>> TwoSumStream::feed(std::span<const int> chunk) {
+    return scan(chunk);
+}
+
+std::optional<std::pair<int64_t, int64_t>> TwoSumStream::feed(std::span<const int64_t> chunk) {
+    return scan(chunk);
+}
+
+WindowedTwoSum::WindowedTwoSum(int64_t targetSum, size_t window)
+    : target_(targetSum), ring_(window), counts_(window) {}
+
+std::optional<std::pair<int64_t, int64_t>> WindowedTwoSum::push(int64_t x) {
+    if (ring_.empty()) return std::nullopt;
+    std::optional<std::pair<int64_t, int64_t>> result;
+    int64_t complement = target_ - x;
+    if (counts_.count(complement)) result = std::make_pair(complement, x);
+
+    // Evict the oldest element once the window is full, then take x in its place
+    if (size_ == ring_.size()) {
+        counts_.remove(ring_[next_]);
+    }
+    else {
+        ++size_;
+    }
+    ring_[next_] = x;
+    counts_.add(x);
+    next_ = next_ + 1 == ring_.size() ? 0 : next_ + 1;
+    return result;
+}
+
+TwoSumIndex::TwoSumIndex(std::span<const int> sequence) : values_(sequence.begin(), sequence.end()) {
+    std::sort(values_.begin(), values_.end());
+    for (size_t i = 1; i < values_.size(); ++i) {
+        if (values_[i] == values_[i - 1] && (repeated_.empty() || repeated_.back() != values_[i])) {
+            repeated_.push_back(values_[i]);
+        }
+    }
+    values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+    values_.shrink_to_fit();
+    if (values_.empty()) return;
+
+    low_ = values_.front();
+    high_ = values_.back();
+    int64_t range = high_ - low_ + 1;
+    // Two bits per value in the range against 32 bits per distinct value
+    if (range > std::max<int64_t>(DIRECT_TABLE_MIN_RANGE, 16 * int64_t(values_.size()))) return;
+    // One zero word of padding, so 64-bit windows can be read from any bit
+    present_.assign(range / 64 + 2, 0);
+    reversed_.assign(range / 64 + 2, 0);
+    for (int value : values_) {
+        present_[(value - low_) / 64] |= uint64_t(1) << ((value - low_) % 64);
+        reversed_[(high_ - value) / 64] |= uint64_t(1) << ((high_ - value) % 64);
+    }
+}
+
+// 64 bits of bits starting at bit position
+static uint64_t bitWindow(const std::vector<uint64_t>& bits, int64_t position) {
+    size_t word = position / 64;
+    int shift = position % 64;
+    return shift ? bits[word] >> shift | bits[word + 1] << (64 - shift) : bits[word];
+}
+
+// The pair a + a, when a = targetSum / 2 appears twice
+static std::optional<std::pair<int, int>> repeatedPair(const std::vector<int>& repeated, int64_t targetSum) {
+    if (targetSum % 2 == 0 && std::binary_search(repeated.begin(), repeated.end(), targetSum / 2)) {
+        return std::make_pair(static_cast<int>(targetSum / 2), static_cast<int>(targetSum / 2));
+    }
+    return std::nullopt;
+}
+
+std::optional<std::pair<int, int>> TwoSumIndex::queryBitset(int64_t targetSum) const {
+    // a < b means a < targetSum / 2, and both have to lie in [low_, high_]
+    int64_t first = std::max(low_, targetSum - high_);
+    int64_t last = std::min(high_, (targetSum - 1) >> 1);  // floor((targetSum - 1) / 2)
+    // Bit a - low_ of present_ pairs with bit high_ - (targetSum - a) of reversed_
+    int64_t offset = high_ + low_ - targetSum;
+    for (int64_t a = first; a <= last; a += 64) {
+        uint64_t both = bitWindow(present_, a - low_) & bitWindow(reversed_, a - low_ + offset);
+        if (last - a < 63) both &= (uint64_t(2) << (last - a)) - 1;
+        if (both) {
+            int64_t found = a + std::countr_zero(both);
+            return std::make_pair(static_cast<int>(found), static_cast<int>(targetSum - found));
+        }
+    }
+    return repeatedPair(repeated_, targetSum);
+}
+
+std::optional<std::pair<int, int>> TwoSumIndex::querySorted(int64_t targetSum) const {
+    // The first pair the sweep meets has the smallest a of all distinct pairs
+    for (size_t left = 0, right = values_.size() - 1; left < right;) {
+        int64_t sum = int64_t(values_[left]) + values_[right];
+        if (sum == targetSum) return std::make_pair(values_[left], values_[right]);
+        if (sum < targetSum) ++left;
+        else --right;
+    }
+    return repeatedPair(repeated_, targetSum);
+}
+
+std::optional<std::pair<int, int>> TwoSumIndex::query(int targetSum) const {
+    if (values_.empty()) return std::nullopt;
+    return present_.empty() ? querySorted(targetSum) : queryBitset(targetSum);
+}
+
+void TwoSumIndex::query(std::span<const int> targets, std::span<std::optional<std::pair<int, int>>> results,
+    ThreadPool* pool) const {
+    if (pool) {
+        pool->parallel_for(0, targets.size(), [&](size_t q) { results[q] = query(targets[q]); });
+    }
+    else {
+        for (size_t q = 0; q < targets.size(); ++q) results[q] = query(targets[q]);
+    }
+}
+
+// Tabulation Solution using C-style arrays
+int* ValuesTabulationCStyle(const int* sequence, int length, int targetSum) {
+    const int MAX_VAL = 1000; // Assuming the values in the sequence are less than 1000
+    static int result[2] = { -1, -1 }; // Static array to return the result
+    int table[MAX_VAL];
+    memset(table, -1, sizeof(table));
+
+    for (int i = 0; i < length; ++i) {
+        int complement = targetSum - sequence[i];
+        if (complement >= 0 && table[complement] != -1) {
+            result[0] = sequence[i];
+            result[1] = complement;
+            return result;
+        }
+        table[sequence[i]] = i;
+    }
+    return result;
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <utility>
+#include <cstdint>
+#include <span>
+
+#include "CpuFeatures.h"
+#include "FlatHashTable.h"
+#include "ThreadPool.h"
+
+// Brute Force Solution
+std::pair<int, int> ValuesBruteForce(std::span<const int> sequence, int targetSum);
+
+// Brute Force Solution comparing targetSum - sequence[i] with 8 (AVX2) or 16
+// (AVX-512) later elements at a time and stopping at the first hit. Returns the
+// same pair as ValuesBruteForce; Scalar, or a level the CPU lacks, falls back.
+std::pair<int, int> ValuesBruteForceSimd(std::span<const int> sequence, int targetSum,
+    SimdLevel level = bestSimdLevel());
+
+// Naive Recursive Solution
+std::optional<std::pair<int, int>> findPairRecursively(const std::vector<int>& arr, int target, int start, int end);
+
+std::optional<std::pair<int, int>> ValuesRecursive(const std::vector<int>& sequence, int targetSum);
+
+// Memoized Recursive Solution with "start,end" string keys, which allocates and
+// hashes a string on every call; kept as the baseline for the memos below
+std::string createKey(int start, int end);
+
+std::optional<std::pair<int, int>> findPairRecursivelyMemo(
+    const std::vector<int>& arr, int target, int start, int end,
+    std::unordered_map<std::string, std::optional<std::pair<int, int>>>& memo);
+
+std::optional<std::pair<int, int>> ValuesMemoizedStringKeys(const std::vector<int>& sequence, int targetSum);
+
+// Memo of findPairRecursivelyMemo keyed by (start, end) packed into 64 bits, in
+// a FlatHashTable; any n, memory proportional to the states visited
+class PackedPairMemo {
+public:
+    bool lookup(int start, int end, std::optional<std::pair<int, int>>& result) const {
+        const std::optional<std::pair<int, int>>* stored = table_.find(key(start, end));
+        if (!stored) return false;
+        result = *stored;
+        return true;
+    }
+
+    void store(int start, int end, const std::optional<std::pair<int, int>>& result) {
+        table_.insert_or_assign(key(start, end), result);
+    }
+
+    // Forget every state in O(1), keeping the table's storage
+    void reset() { table_.clear(); }
+
+private:
+    static uint64_t key(int start, int end) { return uint64_t(uint32_t(start)) << 32 | uint32_t(end); }
+
+    FlatHashTable<uint64_t, std::optional<std::pair<int, int>>> table_;
+};
+
+// Memo of findPairRecursivelyMemo as a dense triangle of the n(n-1)/2 states
+// start < end, 2 bits each: unknown, no pair, or pair found. A search stops at
+// the first pair, so every state that found one found the same pair and a single
+// slot holds it. n^2 / 8 bytes, allocated up front.
+class TrianglePairMemo {
+public:
+    explicit TrianglePairMemo(size_t n = 0) { reset(n); }
+
+    // Forget every state and make room for n elements. The storage only grows,
+    // so a memo reused for sequences no longer than before does not allocate.
+    void reset(size_t n) {
+        size_t words = n < 2 ? 0 : (n * (n - 1) / 2 + 31) / 32;
+        if (states_.size() < words) states_.resize(words);
+        std::fill(states_.begin(), states_.begin() + words, 0);
+        found_.reset();
+    }
+
+    bool lookup(int start, int end, std::optional<std::pair<int, int>>& result) const {
+        size_t cell = index(start, end);
+        unsigned state = states_[cell / 32] >> (cell % 32 * 2) & 3;
+        if (state == UNKNOWN) return false;
+        result = state == FOUND ? found_ : std::nullopt;
+        return true;
+    }
+
+    void store(int start, int end, const std::optional<std::pair<int, int>>& result) {
+        size_t cell = index(start, end);
+        if (result) found_ = result;
+        states_[cell / 32] |= uint64_t(result ? FOUND : NO_PAIR) << (cell % 32 * 2);
+    }
+
+    size_t memory_bytes() const { return states_.size() * sizeof(uint64_t); }
+
+private:
+    static const unsigned UNKNOWN = 0, NO_PAIR = 1, FOUND = 2;
+
+    // Row end holds the end cells start = 0 .. end - 1
+    static size_t index(int start, int end) { return size_t(end) * (end - 1) / 2 + start; }
+
+    std::vector<uint64_t> states_;  // 32 states per word
+    std::optional<std::pair<int, int>> found_;
+};
+
+// Memoized Recursive Solution over any memo with lookup and store like the two
+// above; the recursion is the same as with string keys
+template <typename Memo>
+std::optional<std::pair<int, int>> findPairRecursivelyMemo(
+    const std::vector<int>& arr, int target, int start, int end, Memo& memo) {
+    if (start >= end) {
+        return std::nullopt;
+    }
+    std::optional<std::pair<int, int>> result;
+    if (memo.lookup(start, end, result)) {
+        return result;
+    }
+    if (arr[start] + arr[end] == target) {
+        result = std::make_optional(std::make_pair(arr[start], arr[end]));
+        memo.store(start, end, result);
+        return result;
+    }
+    result = findPairRecursivelyMemo(arr, target, start + 1, end, memo);
+    if (!result) {
+        result = findPairRecursivelyMemo(arr, target, start, end - 1, memo);
+    }
+    memo.store(start, end, result);
+    return result;
+}
+
+// Sequences up to this length use TrianglePairMemo in ValuesMemoized (32 MiB)
+const size_t MEMO_TRIANGLE_MAX_N = 1 << 14;
+
+// Both keep one memo per thread between calls, reset rather than reallocated
+
+std::optional<std::pair<int, int>> ValuesMemoizedPacked(const std::vector<int>& sequence, int targetSum);
+std::optional<std::pair<int, int>> ValuesMemoizedTriangle(const std::vector<int>& sequence, int targetSum);
+
+// Memoized Recursive Solution on TrianglePairMemo, or PackedPairMemo for longer
+// sequences. Same result as ValuesMemoizedStringKeys.
+std::optional<std::pair<int, int>> ValuesMemoized(const std::vector<int>& sequence, int targetSum);
+
+// Tabulation Solution; spans let the same code run on vectors and on mapped int32/int64 files
+std::optional<std::pair<int, int>> ValuesTabulation(std::span<const int> sequence, int targetSum);
+std::optional<std::pair<int64_t, int64_t>> ValuesTabulation(std::span<const int64_t> sequence, int64_t targetSum);
+
+// Tabulation Solution on FlatHashTable instead of std::unordered_map: no allocation
+// per insert and no pointer chasing. The table is sized from sequence.size() up
+// front and reused by later calls on the same thread.
+std::optional<std::pair<int, int>> ValuesTabulationFlat(std::span<const int> sequence, int targetSum);
+std::optional<std::pair<int64_t, int64_t>> ValuesTabulationFlat(std::span<const int64_t> sequence, int64_t targetSum);
+
+// Smallest and largest value, scanned 16 at a time with AVX2 when the CPU has it
+std::pair<int, int> minMaxValues(std::span<const int> sequence);
+
+// Value ranges up to this size, or up to DIRECT_TABLE_SPREAD times the number of
+// elements, use a direct-address table in ValuesTabulationDirect
+const int64_t DIRECT_TABLE_MIN_RANGE = 1 << 16;
+const int64_t DIRECT_TABLE_SPREAD = 4;
+
+// Tabulation Solution generalising ValuesTabulationCStyle to any values: when
+// max - min is small it indexes a table by value - min, like the C-style version
+// but with bounds, otherwise it falls back to ValuesTabulationFlat. The table is
+// reused per thread and the result is returned by value.
+std::optional<std::pair<int, int>> ValuesTabulationDirect(std::span<const int> sequence, int targetSum);
+
+// Tabulation Solution fed one chunk at a time, e.g. by streamFileChunks, so the
+// sequence itself never has to be in memory; only the values seen so far are kept
+class TwoSumStream {
+public:
+    explicit TwoSumStream(int64_t targetSum) : target_(targetSum) {}
+
+    // Scan the next chunk unless a pair was already found; returns the pair found so far
+    std::optional<std::pair<int64_t, int64_t>> feed(std::span<const int> chunk);
+    std::optional<std::pair<int64_t, int64_t>> feed(std::span<const int64_t> chunk);
+
+    const std::optional<std::pair<int64_t, int64_t>>& result() const { return result_; }
+
+private:
+    template <typename T>
+    std::optional<std::pair<int64_t, int64_t>> scan(std::span<const T> chunk);
+
+    int64_t target_;
+    std::unordered_set<int64_t> seen_;
+    std::optional<std::pair<int64_t, int64_t>> result_;
+};
+
+// Two-Sum over an unbounded stream: push(x) reports a pair when targetSum - x is
+// among the `window` elements pushed before x. A ring buffer holds those
+// elements and a FlatCounter counts them, so memory is fixed at construction
+// (see memory_bytes) and each push costs one lookup, one insert and at most one
+// removal.
+class WindowedTwoSum {
+public:
+    WindowedTwoSum(int64_t targetSum, size_t window);
+
+    // The pair (earlier, x) found for x, if any
+    std::optional<std::pair<int64_t, int64_t>> push(int64_t x);
+
+    size_t memory_bytes() const { return ring_.size() * sizeof(int64_t) + counts_.memory_bytes(); }
+
+private:
+    int64_t target_;
+    std::vector<int64_t> ring_;  // the last `window` elements
+    size_t next_ = 0;            // ring position of the oldest element once full
+    size_t size_ = 0;
+    FlatCounter<int64_t> counts_;
+};
+
+// Index over one sequence for answering many targetSum queries without rebuilding
+// a table each time. It keeps the distinct values in sorted order, and, when
+// max - min is small, bitsets of the values present and of those seen at least
+// twice. A query returns the pair (a, b), a <= b, with the smallest a. The bitset
+// path tests 64 candidates for a per step: bit a of the value set is ANDed with
+// bit targetSum - a, read from a reversed copy. Otherwise two pointers sweep the
+// sorted values.
+class TwoSumIndex {
+public:
+    explicit TwoSumIndex(std::span<const int> sequence);
+
+    std::optional<std::pair<int, int>> query(int targetSum) const;
+
+    // results[q] = query(targets[q]); with a pool, the queries run in parallel
+    void query(std::span<const int> targets, std::span<std::optional<std::pair<int, int>>> results,
+        ThreadPool* pool = nullptr) const;
+
+private:
+    std::optional<std::pair<int, int>> queryBitset(int64_t targetSum) const;
+    std::optional<std::pair<int, int>> querySorted(int64_t targetSum) const;
+
+    std::vector<int> values_;         // distinct values, ascending
+    std::vector<int> repeated_;       // values seen at least twice, ascending
+    int64_t low_ = 0, high_ = -1;     // range of the values
+    std::vector<uint64_t> present_;   // bit v - low_ for each value v
+    std::vector<uint64_t> reversed_;  // bit high_ - v for each value v
+};
+
+// Sort and Two-Pointer Solution: an LSD radix sort of the values, keeping their
+// indices, then one sweep inwards from the smallest and largest values. Returns
+// the original indices (smaller first) of a pair adding up to targetSum; when
+// there are several, it is not necessarily the one the other variants find.
+// O(n) time and far less memory than a hash table.
+std::optional<std::pair<size_t, size_t>> IndicesSortTwoPointer(std::span<const int> sequence, int targetSum);
+
+// The values of sequence in ascending order and, for each, its original index,
+// sorted by the same radix sort
+void sortWithIndices(std::span<const int> sequence, std::vector<int>& values, std::vector<size_t>& indices);
+
+// Two-pointer sweep over values sorted ascending: the positions i < j of a pair
+// adding up to targetSum, summed in 64 bits
+std::optional<std::pair<size_t, size_t>> sortedPairPositions(std::span<const int> sorted, int64_t targetSum);
+
+// Tabulation Solution using C-style arrays. Values must be in [0, 1000) and the
+// result lives in a static array; see ValuesTabulationDirect for any input.
+int* ValuesTabulationCStyle(const int* sequence, int length, int targetSum);
@@ -1,131 +1,133 @@
 #include <iostream>
-#include <chrono>
+#include <random>
+#include <string>
 #include <vector>
-#include <algorithm>
-
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
 
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
+#include "Benchmark.h"
+#include "LongestIncreasingSubsequence.h"
+#include "ThreadPool.h"
+
+// True when sequence is strictly increasing and appears in arr in order
+bool isIncreasingSubsequence(const std::vector<int>& sequence, const std::vector<int>& arr) {
+    size_t matched = 0;
+    for (size_t i = 0; i < arr.size() && matched < sequence.size(); ++i) {
+        if (arr[i] == sequence[matched]) ++matched;
     }
-    return total_time / iterations;
+    for (size_t i = 1; i < sequence.size(); ++i) {
+        if (sequence[i] <= sequence[i - 1]) return false;
+    }
+    return matched == sequence.size();
 }
 
-// Iterative Brute Force LIS function
-int longestIncreasingSubsequenceBruteForce(const std::vector<int>& arr) {
-    int n = arr.size();
-    int maxLen = 0;
-
-    // Generate all possible subsequences using bitmasking
-    for (int mask = 1; mask < (1 << n); ++mask) {
-        std::vector<int> subsequence;
-        for (int i = 0; i < n; ++i) {
-            if (mask & (1 << i)) {
-                subsequence.push_back(arr[i]);
-            }
+int main(int argc, char* argv[]) {
+    std::vector<int> arr = { 5, 2, 8, 6, 3, 6, 9, 7 };
+    BenchmarkRunner runner(argc, argv);
+    long long max_n = runner.int_option("--max-n", 100000000);
+    long long max_quadratic_n = runner.int_option("--max-quadratic-n", 10000);
+    long long max_brute_force_n = runner.int_option("--max-brute-force-n", 16);
+    long long max_reconstruct_n = runner.int_option("--max-reconstruct-n", 10000000);
+    long long max_oracle_n = runner.int_option("--max-oracle-n", 40);
+    ThreadPool pool;
+
+    // The original example array, then random arrays of growing size
+    std::vector<long long> sizes = { 8, 16 };
+    for (long long n = 100; n <= max_n; n *= 10) sizes.push_back(n);
+
+    std::mt19937 rng(42);
+    for (long long n : sizes) {
+        if (n != 8) {
+            arr.resize(n);
+            std::uniform_int_distribution<int> value(0, 1000000000);
+            for (auto& v : arr) v = value(rng);
         }
 
-        // Check if the subsequence is strictly increasing
-        bool isIncreasing = true;
-        for (int i = 1; i < subsequence.size(); ++i) {
-            if (subsequence[i] <= subsequence[i - 1]) {
-                isIncreasing = false;
-                break;
-            }
-        }
+        std::cout << "-----------------------------------\n";
+        std::cout << "Calculating LIS in an array of " << n << " elements\n";
+        runner.set_input(std::to_string(arr.size()));
+        double items = static_cast<double>(n);
 
-        if (isIncreasing) {
-            maxLen = std::max(maxLen, (int)subsequence.size());
+        // Measure execution time for LIS using brute force, O(2^n * n)
+        if (n <= max_brute_force_n && n < 64) {
+            runner.run("LIS (Brute Force)", [&] {
+                return longestIncreasingSubsequenceBruteForce(arr);
+                }, items);
         }
-    }
-
-    return maxLen;
-}
-
-// Recursive function to find the length of LIS ending at index i with memoization
-int LIS(int i, const std::vector<int>& arr, std::vector<int>& dp) {
-    if (dp[i] != -1) return dp[i];
 
-    int maxLength = 1; // Minimum LIS ending at index i is 1
-    for (int j = 0; j < i; ++j) {
-        if (arr[j] < arr[i]) {
-            maxLength = std::max(maxLength, LIS(j, arr, dp) + 1);
+        // Measure execution time for LIS using memoization and tabulation, O(n^2)
+        if (n <= max_quadratic_n) {
+            runner.run("LIS (Memoization)", [&] {
+                return longestIncreasingSubsequenceMemoization(arr);
+                }, items);
+
+            runner.run("LIS (Tabulation)", [&] {
+                return longestIncreasingSubsequenceTabulation(arr);
+                }, items);
+
+            // Measure execution time for the branchless and SIMD tabulations the CPU supports
+            for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512 }) {
+                if (supportedSimdLevel(level) != level) continue;
+                runner.run(std::string("LIS (Tabulation, ") + simdLevelName(level) + ")", [&] {
+                    return longestIncreasingSubsequenceTabulationSimd(arr, level);
+                    }, items);
+                if (longestIncreasingSubsequenceTabulationSimd(arr, level) != longestIncreasingSubsequenceTabulation(arr)) {
+                    std::cout << "Mismatch: " << simdLevelName(level) << " tabulation disagrees with tabulation\n";
+                }
+            }
         }
-    }
-    dp[i] = maxLength;
-    return dp[i];
-}
 
-// Function to find the length of the Longest Increasing Subsequence using memoization
-int longestIncreasingSubsequenceMemoization(const std::vector<int>& arr) {
-    int n = arr.size();
-    if (n == 0) return 0;
-
-    std::vector<int> dp(n, -1);
-    int maxLength = 1;
-    for (int i = 0; i < n; ++i) {
-        maxLength = std::max(maxLength, LIS(i, arr, dp));
-    }
-
-    return maxLength;
-}
-
-// Function to find the length of the Longest Increasing Subsequence using tabulation
-int longestIncreasingSubsequenceTabulation(const std::vector<int>& arr) {
-    int n = arr.size();
-    if (n == 0) return 0;
-
-    std::vector<int> dp(n, 1);
-    int maxLength = 1;
+        // Measure execution time for LIS using patience sorting, O(n log n)
+        runner.run("LIS (Patience Sorting)", [&] {
+            return longestIncreasingSubsequencePatience(arr);
+            }, items);
+        int length = longestIncreasingSubsequencePatience(arr);
+        if (n <= max_quadratic_n && length != longestIncreasingSubsequenceTabulation(arr)) {
+            std::cout << "Mismatch: patience sorting disagrees with tabulation\n";
+        }
 
-    for (int i = 1; i < n; ++i) {
-        for (int j = 0; j < i; ++j) {
-            if (arr[i] > arr[j]) {
-                dp[i] = std::max(dp[i], dp[j] + 1);
+        // Measure execution time for patience sorting that also returns the subsequence
+        if (n <= max_reconstruct_n) {
+            runner.run("LIS (Patience Sorting, reconstructed)", [&] {
+                return longestIncreasingSubsequenceReconstruct(arr);
+                }, items);
+            std::vector<int> sequence = longestIncreasingSubsequenceReconstruct(arr);
+            if (static_cast<int>(sequence.size()) != length || !isIncreasingSubsequence(sequence, arr)) {
+                std::cout << "Mismatch: reconstructed subsequence is not a longest increasing subsequence\n";
             }
         }
-        maxLength = std::max(maxLength, dp[i]);
+        std::cout << "LIS length = " << length << "\n";
     }
 
-    return maxLength;
-}
-
-int main() {
-    std::vector<int> arr = { 5, 2, 8, 6, 3, 6, 9, 7 };
-    int iterations = 1000;
-
-    std::cout << "-----------------------------------\n";
-    std::cout << "Calculating LIS in the array\n";
-
-    // Measure average execution time for LIS using brute force
-    auto bruteForceTime = average_time([](const std::vector<int>& arr) {
-        longestIncreasingSubsequenceBruteForce(arr);
-        }, iterations, arr);
-    std::cout << "Average time for LIS (Brute Force): " << bruteForceTime << " ns\n";
-
-    // Measure average execution time for LIS using memoization
-    auto memoizationTime = average_time([](const std::vector<int>& arr) {
-        longestIncreasingSubsequenceMemoization(arr);
-        }, iterations, arr);
-    std::cout << "Average time for LIS (Memoization): " << memoizationTime << " ns\n";
-
-    // Measure average execution time for LIS using tabulation
-    auto tabulationTime = average_time([](const std::vector<int>& arr) {
-        longestIncreasingSubsequenceTabulation(arr);
-        }, iterations, arr);
-    std::cout << "Average time for LIS (Tabulation): " << tabulationTime << " ns\n";
+    // The exhaustive searches are the ground truth for the variants above; time
+    // them on random arrays up to --max-oracle-n elements
+    for (long long n = 20; n <= max_oracle_n && n < 64; n += 4) {
+        arr.resize(n);
+        std::uniform_int_distribution<int> value(0, 1000000000);
+        for (auto& v : arr) v = value(rng);
+        std::cout << "-----------------------------------\n";
+        std::cout << "Exhaustive LIS of an array of " << n << " elements\n";
+        runner.set_input(std::to_string(n) + " exhaustive");
+
+        runner.run("LIS (Brute Force)", [&] {
+            return longestIncreasingSubsequenceBruteForce(arr);
+            });
+        runner.run("LIS (Brute Force, " + std::to_string(pool.size()) + " threads)", [&] {
+            return longestIncreasingSubsequenceBruteForce(arr, &pool);
+            });
+        runner.run("LIS (Branch and Bound)", [&] {
+            return longestIncreasingSubsequenceBranchAndBound(arr);
+            });
+        runner.run("LIS (Branch and Bound, " + std::to_string(pool.size()) + " threads)", [&] {
+            return longestIncreasingSubsequenceBranchAndBound(arr, &pool);
+            });
+
+        int length = longestIncreasingSubsequencePatience(arr);
+        if (longestIncreasingSubsequenceBruteForce(arr) != length || longestIncreasingSubsequenceBruteForce(arr, &pool) != length
+            || longestIncreasingSubsequenceBranchAndBound(arr) != length
+            || longestIncreasingSubsequenceBranchAndBound(arr, &pool) != length) {
+            std::cout << "Mismatch: exhaustive search disagrees with patience sorting\n";
+        }
+        std::cout << "LIS length = " << length << "\n";
+    }
 
     std::cout << "-----------------------------------\n";
 
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Fibonacci.h"
+#include "ModularQueries.h"
+#include "PathCounting.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long query_count = runner.int_option("--queries", 1000000);
+    long long single_count = runner.int_option("--single-queries", 1000);
+    std::mt19937_64 rng(42);
+
+    // Spot checks against the exact int versions, which agree while the values fit
+    for (int n = 0; n <= 40; ++n) {
+        if (fibonacci_mod(n) != static_cast<uint32_t>(fibonacci_tabulation(n))) {
+            std::cout << "Mismatch: fibonacci_mod(" << n << ")\n";
+        }
+    }
+    for (int m = 1; m <= 15; ++m) {
+        for (int n = 1; n <= 15; ++n) {
+            if (countPathsMod(m, n) != static_cast<uint32_t>(countPathsTabulation(m, n))) {
+                std::cout << "Mismatch: countPathsMod(" << m << ", " << n << ")\n";
+            }
+        }
+    }
+
+    // Dense indices below 10^6: answered from one table of F mod p
+    std::vector<unsigned long long> dense(query_count);
+    std::uniform_int_distribution<unsigned long long> dense_n(0, 999999);
+    for (auto& n : dense) n = dense_n(rng);
+
+    // Sparse indices up to 10^18: answered from a table of jumps per byte of n
+    std::vector<unsigned long long> sparse(query_count);
+    std::uniform_int_distribution<unsigned long long> sparse_n(0, 1000000000000000000ull);
+    for (auto& n : sparse) n = sparse_n(rng);
+
+    std::vector<uint32_t> dense_answers = fibonacci_mod_batch(dense);
+    std::vector<uint32_t> sparse_answers = fibonacci_mod_batch(sparse);
+    for (long long i = 0; i < std::min(query_count, single_count); ++i) {
+        if (dense_answers[i] != fibonacci_mod(dense[i]) || sparse_answers[i] != fibonacci_mod(sparse[i])) {
+            std::cout << "Mismatch: batched and single Fibonacci queries disagree at " << i << "\n";
+            break;
+        }
+    }
+
+    std::cout << "Fibonacci(n) mod " << DEFAULT_MODULUS << "\n";
+    runner.set_input(std::to_string(query_count) + " dense n < 1e6");
+    runner.run("batch (tabulated)", [&] { return fibonacci_mod_batch(dense); }, static_cast<double>(query_count));
+    runner.run("one query at a time", [&] {
+        uint32_t sum = 0;
+        for (long long i = 0; i < single_count; ++i) sum += fibonacci_mod(dense[i]);
+        return sum;
+        }, static_cast<double>(single_count));
+
+    runner.set_input(std::to_string(query_count) + " sparse n < 1e18");
+    runner.run("batch (byte jump table)", [&] { return fibonacci_mod_batch(sparse); }, static_cast<double>(query_count));
+    runner.run("one query at a time", [&] {
+        uint32_t sum = 0;
+        for (long long i = 0; i < single_count; ++i) sum += fibonacci_mod(sparse[i]);
+        return sum;
+        }, static_cast<double>(single_count));
+    std::cout << "-----------------------------------\n";
+
+    // Grids up to 10^5 x 10^5
+    std::vector<std::pair<int, int>> grids(query_count);
+    std::uniform_int_distribution<int> side(1, 100000);
+    for (auto& grid : grids) grid = { side(rng), side(rng) };
+
+    std::vector<uint32_t> path_answers = countPathsModBatch(grids);
+    for (long long i = 0; i < std::min(query_count, single_count); ++i) {
+        if (path_answers[i] != countPathsMod(grids[i].first, grids[i].second)) {
+            std::cout << "Mismatch: batched and single path counts disagree at " << i << "\n";
+            break;
+        }
+    }
+
+    std::cout << "Paths in an m x n grid mod " << DEFAULT_MODULUS << "\n";
+    runner.set_input(std::to_string(query_count) + " grids up to 1e5 x 1e5");
+    runner.run("batch (factorial table)", [&] { return countPathsModBatch(grids); }, static_cast<double>(query_count));
+    runner.run("one query at a time", [&] {
+        uint32_t sum = 0;
+        for (long long i = 0; i < single_count; ++i) sum += countPathsMod(grids[i].first, grids[i].second);
+        return sum;
+        }, static_cast<double>(single_count));
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "GridPaths.h"
+#include "ModularQueries.h"
+#include "ThreadPool.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long size = runner.int_option("--size", 10000);
+    long long blocked_percent = runner.int_option("--blocked-percent", 10);
+    long long max_threads = runner.int_option("--max-threads", std::thread::hardware_concurrency());
+    long long tile = runner.int_option("--tile", GRID_TILE);
+    if (max_threads < 1) max_threads = 1;
+
+    // An empty grid has the closed-form count, whatever the tiling
+    PathGrid empty(300, 200);
+    if (countGridPaths(empty, nullptr, DEFAULT_MODULUS, 64) != countPathsMod(300, 200)) {
+        std::cout << "Mismatch: empty grid disagrees with the closed form\n";
+    }
+
+    // Random obstacles and costs 1-9; start and end stay open
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> percent(0, 99), weight(1, 9);
+    PathGrid grid(static_cast<int>(size), static_cast<int>(size));
+    grid.cost.resize(grid.blocked.size());
+    for (size_t i = 0; i < grid.blocked.size(); ++i) {
+        grid.blocked[i] = percent(rng) < blocked_percent;
+        grid.cost[i] = weight(rng);
+    }
+    grid.blocked.front() = grid.blocked.back() = 0;
+
+    // Reference answers from a single untiled pass
+    uint32_t expected_count = countGridPaths(grid, nullptr, DEFAULT_MODULUS, static_cast<int>(size));
+    uint64_t expected_cost = minCostGridPath(grid, nullptr, static_cast<int>(size));
+    std::cout << size << "x" << size << " grid, " << blocked_percent << "% blocked: " << expected_count
+        << " paths mod " << DEFAULT_MODULUS << ", minimum cost " << expected_cost << "\n";
+    std::cout << "-----------------------------------\n";
+
+    double cells = static_cast<double>(size) * size;
+    runner.set_input(std::to_string(size) + "x" + std::to_string(size) + " untiled");
+    runner.run("path count", [&] { return countGridPaths(grid, nullptr, DEFAULT_MODULUS, static_cast<int>(size)); }, cells);
+    runner.run("minimum cost", [&] { return minCostGridPath(grid, nullptr, static_cast<int>(size)); }, cells);
+
+    // Powers of two up to the core count, then the core count itself
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(static_cast<int>(max_threads));
+
+    for (int threads : thread_counts) {
+        ThreadPool pool(threads);
+        runner.set_input(std::to_string(size) + "x" + std::to_string(size) + " tile " + std::to_string(tile) + ", "
+            + std::to_string(threads) + " threads");
+
+        runner.run("path count", [&] { return countGridPaths(grid, &pool, DEFAULT_MODULUS, static_cast<int>(tile)); }, cells);
+        if (countGridPaths(grid, &pool, DEFAULT_MODULUS, static_cast<int>(tile)) != expected_count) {
+            std::cout << "Mismatch: tiled path count disagrees with the untiled pass\n";
+        }
+
+        runner.run("minimum cost", [&] { return minCostGridPath(grid, &pool, static_cast<int>(tile)); }, cells);
+        if (minCostGridPath(grid, &pool, static_cast<int>(tile)) != expected_cost) {
+            std::cout << "Mismatch: tiled minimum cost disagrees with the untiled pass\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LongestIncreasingSubsequence.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long stream_length = runner.int_option("--elements", 10000000);
+    long long max_rerun_n = runner.int_option("--max-rerun-n", 3000);
+    long long max_window = runner.int_option("--max-window", 10000);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> value(0, 1000000000);
+    std::vector<int> stream(stream_length);
+    for (auto& v : stream) v = value(rng);
+
+    // The online length after each append must match a full recomputation
+    OnlineLIS check;
+    for (long long i = 0; i < std::min(stream_length, 2000LL); ++i) {
+        check.append(stream[i]);
+        if (check.length() != longestIncreasingSubsequenceTabulation(std::span<const int>(stream).first(i + 1))) {
+            std::cout << "Mismatch: OnlineLIS disagrees with tabulation after " << i + 1 << " elements\n";
+            break;
+        }
+    }
+    SlidingWindowLIS window_check(50);
+    for (long long i = 0; i < std::min(stream_length, 2000LL); ++i) {
+        window_check.append(stream[i]);
+        long long first = std::max(0LL, i + 1 - 50);
+        if (window_check.length() != longestIncreasingSubsequencePatience(
+            std::span<const int>(stream).subspan(first, i + 1 - first))) {
+            std::cout << "Mismatch: SlidingWindowLIS disagrees with patience sorting after " << i + 1 << " elements\n";
+            break;
+        }
+    }
+
+    // Length after every append, summed so no query can be skipped
+    std::cout << "LIS length after every append\n";
+    runner.set_input(std::to_string(stream_length) + " appends");
+    runner.run("OnlineLIS", [&] {
+        OnlineLIS lis;
+        long long total = 0;
+        for (int x : stream) {
+            lis.append(x);
+            total += lis.length();
+        }
+        return total;
+        }, static_cast<double>(stream_length));
+
+    // Recomputing from scratch is quadratic or worse in the stream length
+    runner.set_input(std::to_string(max_rerun_n) + " appends");
+    runner.run("patience sorting rerun per append", [&] {
+        long long total = 0;
+        for (long long i = 1; i <= max_rerun_n; ++i) {
+            total += longestIncreasingSubsequencePatience(std::span<const int>(stream).first(i));
+        }
+        return total;
+        }, static_cast<double>(max_rerun_n));
+    long long tabulation_n = std::min(max_rerun_n, 1000LL);
+    runner.set_input(std::to_string(tabulation_n) + " appends");
+    runner.run("tabulation rerun per append", [&] {
+        long long total = 0;
+        for (long long i = 1; i <= tabulation_n; ++i) {
+            total += longestIncreasingSubsequenceTabulation(std::span<const int>(stream).first(i));
+        }
+        return total;
+        }, static_cast<double>(tabulation_n));
+    std::cout << "-----------------------------------\n";
+
+    // Sliding windows cost O(window log LIS) per append, so fewer appends are timed for wide windows
+    std::cout << "LIS of the last W elements after every append\n";
+    for (long long window = 10; window <= max_window; window *= 10) {
+        long long appends = std::min(stream_length, 20000000 / window);
+        runner.set_input("W=" + std::to_string(window) + ", " + std::to_string(appends) + " appends");
+        runner.run("SlidingWindowLIS", [&] {
+            SlidingWindowLIS lis(window);
+            long long total = 0;
+            for (long long i = 0; i < appends; ++i) {
+                lis.append(stream[i]);
+                total += lis.length();
+            }
+            return total;
+            }, static_cast<double>(appends));
+    }
+
+    return 0;
+}
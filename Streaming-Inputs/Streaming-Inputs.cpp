@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "GridPaths.h"
+#include "LongestIncreasingSubsequence.h"
+#include "MappedFile.h"
+#include "TwoSum.h"
+
+// Whole file copied into a vector, the way the examples would read it without mapping
+template <typename T>
+std::vector<T> readIntoVector(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<T> values(MappedFile::file_size(path) / sizeof(T));
+    in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+    return values;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long elements = runner.int_option("--elements", 1 << 20);
+    long long lis_elements = runner.int_option("--lis-elements", 10000);
+    long long chunk_elements = runner.int_option("--chunk-elements", 1 << 16);
+    long long grid_size = runner.int_option("--grid-size", 10000);
+    long long chunk_rows = runner.int_option("--chunk-rows", 512);
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string int32_path = (dir / "dp_sequence_int32.bin").string();
+    std::string int64_path = (dir / "dp_sequence_int64.bin").string();
+    std::string grid_path = (dir / "dp_grid.bitmap").string();
+
+    // Random values below 10^9 and a negative target: no pair exists, so every variant scans everything
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> value(0, 999999999);
+    std::vector<int> sequence(elements);
+    for (auto& v : sequence) v = value(rng);
+    std::vector<int64_t> wide(sequence.begin(), sequence.end());
+    writeSequenceFile<int>(int32_path, sequence);
+    writeSequenceFile<int64_t>(int64_path, wide);
+    const int targetSum = -1;
+
+    PathGrid grid(static_cast<int>(grid_size), static_cast<int>(grid_size));
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (auto& cell : grid.blocked) cell = percent(rng) < 10;
+    grid.blocked.front() = grid.blocked.back() = 0;
+    writeGridBitmap(grid_path, grid);
+
+    double count = static_cast<double>(elements);
+    std::cout << "Two-Sum tabulation over " << elements << " values\n";
+    runner.set_input(std::to_string(elements) + " int32");
+    runner.run("read into vector", [&] { return ValuesTabulation(readIntoVector<int>(int32_path), targetSum); }, count);
+    runner.run("mapped span", [&] {
+        MappedFile file(int32_path);
+        return ValuesTabulation(file.elements<int>(), targetSum);
+        }, count);
+    runner.run("streamed chunks", [&] {
+        TwoSumStream stream(targetSum);
+        streamFileChunks<int>(int32_path, chunk_elements, [&](std::span<const int> chunk) { stream.feed(chunk); });
+        return stream.result();
+        }, count);
+
+    runner.set_input(std::to_string(elements) + " int64");
+    runner.run("mapped span", [&] {
+        MappedFile file(int64_path);
+        return ValuesTabulation(file.elements<int64_t>(), targetSum);
+        }, count);
+    runner.run("streamed chunks", [&] {
+        TwoSumStream stream(targetSum);
+        streamFileChunks<int64_t>(int64_path, chunk_elements, [&](std::span<const int64_t> chunk) { stream.feed(chunk); });
+        return stream.result();
+        }, count);
+    std::cout << "-----------------------------------\n";
+
+    // The quadratic LIS only reads a prefix of the file
+    std::cout << "LIS tabulation over the first " << lis_elements << " values\n";
+    runner.set_input(std::to_string(lis_elements) + " int32");
+    int expected_lis = longestIncreasingSubsequenceTabulation(std::span<const int>(sequence).first(lis_elements));
+    runner.run("vector", [&] {
+        return longestIncreasingSubsequenceTabulation(std::span<const int>(sequence).first(lis_elements));
+        }, static_cast<double>(lis_elements));
+    runner.run("mapped span", [&] {
+        MappedFile file(int32_path, 0, lis_elements * sizeof(int));
+        return longestIncreasingSubsequenceTabulation(file.elements<int>());
+        }, static_cast<double>(lis_elements));
+    MappedFile wide_prefix(int64_path, 0, lis_elements * sizeof(int64_t));
+    if (longestIncreasingSubsequenceTabulation(wide_prefix.elements<int64_t>()) != expected_lis) {
+        std::cout << "Mismatch: LIS of the mapped int64 file disagrees with the vector\n";
+    }
+    std::cout << "-----------------------------------\n";
+
+    // Grid paths from the byte grid, the mapped bitmap and bitmap chunks
+    uint32_t expected_paths = countGridPaths(grid);
+    std::cout << "Grid paths on a " << grid_size << "x" << grid_size << " grid, bitmap of "
+        << MappedFile::file_size(grid_path) << " bytes\n";
+    runner.set_input(std::to_string(grid_size) + "x" + std::to_string(grid_size));
+    double cells = static_cast<double>(grid_size) * grid_size;
+    runner.run("byte grid in memory", [&] { return countGridPaths(grid); }, cells);
+    runner.run("mapped bitmap", [&] {
+        MappedFile file(grid_path);
+        return countGridPaths(mapGridBitmap(file));
+        }, cells);
+    runner.run("streamed bitmap chunks", [&] {
+        return countGridPathsStreaming(grid_path, static_cast<int>(chunk_rows));
+        }, cells);
+
+    MappedFile grid_file(grid_path);
+    if (countGridPaths(mapGridBitmap(grid_file)) != expected_paths ||
+        countGridPathsStreaming(grid_path, static_cast<int>(chunk_rows)) != expected_paths ||
+        countGridPathsStreaming(grid_path, 7) != expected_paths) {
+        std::cout << "Mismatch: bitmap path counts disagree with the byte grid\n";
+    }
+
+    std::filesystem::remove(int32_path);
+    std::filesystem::remove(int64_path);
+    std::filesystem::remove(grid_path);
+    return 0;
+}
@@ -1,169 +1,180 @@
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
-#include <unordered_map>
-#include <optional>
-#include <utility>
-#include <chrono>
-#include <cstring> // Para usar memset
-
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
-
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
-    }
-    return total_time / iterations;
-}
-
-// Brute Force Solution
-std::pair<int, int> ValuesBruteForce(const std::vector<int>& sequence, int targetSum) {
-    int n = sequence.size();
-    for (int i = 0; i < n - 1; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            if (sequence[i] + sequence[j] == targetSum) {
-                return std::make_pair(sequence[i], sequence[j]);
-            }
-        }
-    }
-    return std::make_pair(-1, -1);
-}
-
-// Naive Recursive Solution
-std::optional<std::pair<int, int>> findPairRecursively(const std::vector<int>& arr, int target, int start, int end) {
-    if (start >= end) {
-        return std::nullopt;
-    }
-    if (arr[start] + arr[end] == target) {
-        return std::make_optional(std::make_pair(arr[start], arr[end]));
-    }
-    auto result = findPairRecursively(arr, target, start + 1, end);
-    if (result) {
-        return result;
-    }
-    return findPairRecursively(arr, target, start, end - 1);
-}
-
-std::optional<std::pair<int, int>> ValuesRecursive(const std::vector<int>& sequence, int targetSum) {
-    return findPairRecursively(sequence, targetSum, 0, sequence.size() - 1);
-}
-
-// Memoized Recursive Solution
-std::string createKey(int start, int end) {
-    return std::to_string(start) + "," + std::to_string(end);
-}
-
-std::optional<std::pair<int, int>> findPairRecursivelyMemo(
-    const std::vector<int>& arr, int target, int start, int end,
-    std::unordered_map<std::string, std::optional<std::pair<int, int>>>& memo) {
-    if (start >= end) {
-        return std::nullopt;
-    }
-    std::string key = createKey(start, end);
-    if (memo.find(key) != memo.end()) {
-        return memo[key];
-    }
-    if (arr[start] + arr[end] == target) {
-        auto result = std::make_optional(std::make_pair(arr[start], arr[end]));
-        memo[key] = result;
-        return result;
-    }
-    auto result = findPairRecursivelyMemo(arr, target, start + 1, end, memo);
-    if (result) {
-        memo[key] = result;
-        return result;
-    }
-    result = findPairRecursivelyMemo(arr, target, start, end - 1, memo);
-    memo[key] = result;
-    return result;
-}
-
-std::optional<std::pair<int, int>> ValuesMemoized(const std::vector<int>& sequence, int targetSum) {
-    std::unordered_map<std::string, std::optional<std::pair<int, int>>> memo;
-    return findPairRecursivelyMemo(sequence, targetSum, 0, sequence.size() - 1, memo);
-}
-
-// Tabulation Solution
-std::optional<std::pair<int, int>> ValuesTabulation(const std::vector<int>& sequence, int targetSum) {
-    std::unordered_map<int, int> table;
-    for (int i = 0; i < sequence.size(); ++i) {
-        int complement = targetSum - sequence[i];
-        if (table.find(complement) != table.end()) {
-            return std::make_optional(std::make_pair(sequence[i], complement));
-        }
-        table[sequence[i]] = i;
-    }
-    return std::nullopt;
-}
 
-// Tabulation Solution using C-style arrays
-int* ValuesTabulationCStyle(const int* sequence, int length, int targetSum) {
-    const int MAX_VAL = 1000; // Assuming the values in the sequence are less than 1000
-    static int result[2] = { -1, -1 }; // Static array to return the result
-    int table[MAX_VAL];
-    memset(table, -1, sizeof(table));
-
-    for (int i = 0; i < length; ++i) {
-        int complement = targetSum - sequence[i];
-        if (complement >= 0 && table[complement] != -1) {
-            result[0] = sequence[i];
-            result[1] = complement;
-            return result;
-        }
-        table[sequence[i]] = i;
-    }
-    return result;
-}
+#include "Benchmark.h"
+#include "TwoSum.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     std::vector<int> sequence = { 8, 10, 2, 9, 7, 5 };; // 40 numbers
     int targetSum = 11;
-    int iterations = 1000;
+    BenchmarkRunner runner(argc, argv);
+    long long max_n = runner.int_option("--max-n", 100000000);
+    long long max_map_n = runner.int_option("--max-map-n", 10000000);
+    long long max_brute_force_n = runner.int_option("--max-brute-force-n", 100000);
+    long long max_recursive_n = runner.int_option("--max-recursive-n", 20);
+    long long max_memo_n = runner.int_option("--max-memo-n", 1000);
 
     std::cout << "-----------------------------------\n";
     std::cout << "Calculating Two-Sum (" << targetSum << ")\n";
+    runner.set_input(std::to_string(sequence.size()));
+
+    // Measure execution time for Brute Force Solution
+    runner.run("Brute Force", [&] {
+        return ValuesBruteForce(sequence, targetSum);
+        });
+
+    // Measure execution time for the SIMD Brute Force Solution
+    runner.run("Brute Force SIMD", [&] {
+        return ValuesBruteForceSimd(sequence, targetSum);
+        });
+
+    // Measure execution time for Naive Recursive Solution
+    runner.run("Recursive", [&] {
+        return ValuesRecursive(sequence, targetSum);
+        });
+
+    // Measure execution time for Memoized Recursive Solution
+    runner.run("Memoized", [&] {
+        return ValuesMemoizedStringKeys(sequence, targetSum);
+        });
+
+    // Measure execution time for Memoized Recursive Solution on the dense triangle memo
+    runner.run("Memoized Triangle", [&] {
+        return ValuesMemoized(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution
+    runner.run("Tabulation", [&] {
+        return ValuesTabulation(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution on the flat hash table
+    runner.run("Tabulation Flat", [&] {
+        return ValuesTabulationFlat(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution using C-style arrays
+    runner.run("Tabulation C-Style", [&] {
+        return ValuesTabulationCStyle(sequence.data(), sequence.size(), targetSum);
+        });
+
+    // Random even values with an odd target have no pair, so every variant scans
+    // its whole input. Uniform 30-bit values, values below 1000 (what the C-style
+    // table assumes) and exponentially skewed values with many repeats
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> uniform(0, (1 << 29) - 1);
+    std::uniform_int_distribution<int> small(0, 499);
+    std::exponential_distribution<double> skewed(1.0 / 65536);
+    struct Distribution {
+        const char* name;
+        std::function<int()> draw;
+    };
+    std::vector<Distribution> distributions = {
+        { "uniform", [&] { return 2 * uniform(rng); } },
+        { "< 1000", [&] { return 2 * small(rng); } },
+        { "skewed", [&] { return 2 * static_cast<int>(std::min(skewed(rng), double((1 << 29) - 1))); } },
+    };
+
+    for (const Distribution& distribution : distributions) {
+        for (long long n = 10; n <= max_n; n *= 10) {
+            sequence.resize(n);
+            for (auto& v : sequence) v = distribution.draw();
+            int missingSum = 1;
+
+            std::cout << "-----------------------------------\n";
+            std::cout << "Calculating Two-Sum of " << n << " values (" << distribution.name << "), no pair\n";
+            runner.set_input(std::to_string(n) + ", " + distribution.name);
+            double items = static_cast<double>(n);
+
+            // The exhaustive variants only fit small inputs
+            if (n <= max_brute_force_n) {
+                runner.run("Brute Force", [&] {
+                    return ValuesBruteForce(sequence, missingSum);
+                    }, items);
+                for (SimdLevel level : { SimdLevel::Avx2, SimdLevel::Avx512 }) {
+                    if (supportedSimdLevel(level) != level) continue;
+                    runner.run(std::string("Brute Force ") + simdLevelName(level), [&] {
+                        return ValuesBruteForceSimd(sequence, missingSum, level);
+                        }, items);
+                }
+            }
+            if (n <= max_recursive_n) {
+                runner.run("Recursive", [&] {
+                    return ValuesRecursive(sequence, missingSum);
+                    }, items);
+            }
+            // Every state (start, end) is visited once, so the memo's cost per
+            // state is all that differs
+            if (n <= max_memo_n) {
+                double stringKeys = runner.run("Memoized", [&] {
+                    return ValuesMemoizedStringKeys(sequence, missingSum);
+                    }, items).median;
+                double packed = runner.run("Memoized Packed", [&] {
+                    return ValuesMemoizedPacked(sequence, missingSum);
+                    }, items).median;
+                double triangle = runner.run("Memoized Triangle", [&] {
+                    return ValuesMemoizedTriangle(sequence, missingSum);
+                    }, items).median;
+                std::cout << "Memoized speedup over string keys: packed keys " << stringKeys / packed
+                    << "x, triangle " << stringKeys / triangle << "x\n";
+            }
 
-    // Measure average execution time for Brute Force Solution
-    auto bruteForceTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesBruteForce(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Brute Force: " << bruteForceTime << " ns\n";
-
-    // Measure average execution time for Naive Recursive Solution
-    auto recursiveTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesRecursive(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Recursive: " << recursiveTime << " ns\n";
-
-    // Measure average execution time for Memoized Recursive Solution
-    auto memoizedTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesMemoized(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Memoized: " << memoizedTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution
-    auto tabulationTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesTabulation(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Tabulation: " << tabulationTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution using C-style arrays
-    auto tabulationCStyleTime = average_time([](const int* seq, int length, int target) {
-        ValuesTabulationCStyle(seq, length, target);
-        }, iterations, sequence.data(), sequence.size(), targetSum);
-    std::cout << "Average time for Tabulation C-Style: " << tabulationCStyleTime << " ns\n";
-
-   std::cout << "-----------------------------------\n";
+            // std::unordered_map allocates a node per element, ~40 bytes each
+            if (n <= max_map_n) {
+                runner.run("Tabulation", [&] {
+                    return ValuesTabulation(sequence, missingSum);
+                    }, items);
+            }
+            runner.run("Tabulation Flat", [&] {
+                return ValuesTabulationFlat(sequence, missingSum);
+                }, items);
+            runner.run("Tabulation Direct", [&] {
+                return ValuesTabulationDirect(sequence, missingSum);
+                }, items);
+            if (minMaxValues(sequence).second < 1000) {
+                runner.run("Tabulation C-Style", [&] {
+                    return ValuesTabulationCStyle(sequence.data(), sequence.size(), missingSum)[0];
+                    }, items);
+            }
+            runner.run("Sort Two-Pointer", [&] {
+                return IndicesSortTwoPointer(sequence, missingSum);
+                }, items);
+
+            // A pair that exists must come out the same from both tables; the
+            // two-pointer sweep may find another pair, so check its indices
+            std::uniform_int_distribution<long long> index(0, n - 1), other(0, n - 2);
+            long long first = index(rng), second = other(rng);
+            int pairSum = sequence[first] + sequence[second < first ? second : second + 1];
+            if (ValuesTabulationFlat(sequence, missingSum) || (n <= max_map_n && ValuesTabulationFlat(sequence, pairSum) != ValuesTabulation(sequence, pairSum))) {
+                std::cout << "Mismatch: flat table disagrees with std::unordered_map\n";
+            }
+            if (n <= max_memo_n) {
+                auto expected = ValuesMemoizedStringKeys(sequence, pairSum);
+                if (ValuesMemoizedPacked(sequence, pairSum) != expected || ValuesMemoizedTriangle(sequence, pairSum) != expected) {
+                    std::cout << "Mismatch: memo backends disagree with string keys\n";
+                }
+            }
+            if (n <= max_brute_force_n) {
+                for (SimdLevel level : { SimdLevel::Avx2, SimdLevel::Avx512 }) {
+                    if (ValuesBruteForceSimd(sequence, pairSum, level) != ValuesBruteForce(sequence, pairSum)
+                        || ValuesBruteForceSimd(sequence, missingSum, level) != ValuesBruteForce(sequence, missingSum)) {
+                        std::cout << "Mismatch: " << simdLevelName(level) << " brute force disagrees with brute force\n";
+                    }
+                }
+            }
+            auto indices = IndicesSortTwoPointer(sequence, pairSum);
+            if (IndicesSortTwoPointer(sequence, missingSum) || !indices || indices->first >= indices->second
+                || sequence[indices->first] + sequence[indices->second] != pairSum) {
+                std::cout << "Mismatch: sort and two-pointer returned no valid pair of indices\n";
+            }
+        }
+    }
+
+    std::cout << "-----------------------------------\n";
 
     return 0;
 }
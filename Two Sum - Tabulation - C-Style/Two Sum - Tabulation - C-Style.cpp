@@ -1,170 +1,101 @@
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
-#include <unordered_map>
-#include <optional>
-#include <utility>
-#include <chrono>
-#include <cstring> // Para usar memset
-
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
 
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
-    }
-    return total_time / iterations;
-}
-
-// Brute Force Solution
-std::pair<int, int> ValuesBruteForce(const std::vector<int>& sequence, int targetSum) {
-    int n = sequence.size();
-    for (int i = 0; i < n - 1; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            if (sequence[i] + sequence[j] == targetSum) {
-                return std::make_pair(sequence[i], sequence[j]);
-            }
-        }
-    }
-    return std::make_pair(-1, -1);
-}
+#include "Benchmark.h"
+#include "TwoSum.h"
 
-// Naive Recursive Solution
-std::optional<std::pair<int, int>> findPairRecursively(const std::vector<int>& arr, int target, int start, int end) {
-    if (start >= end) {
-        return std::nullopt;
-    }
-    if (arr[start] + arr[end] == target) {
-        return std::make_optional(std::make_pair(arr[start], arr[end]));
-    }
-    auto result = findPairRecursively(arr, target, start + 1, end);
-    if (result) {
-        return result;
-    }
-    return findPairRecursively(arr, target, start, end - 1);
-}
-
-std::optional<std::pair<int, int>> ValuesRecursive(const std::vector<int>& sequence, int targetSum) {
-    return findPairRecursively(sequence, targetSum, 0, sequence.size() - 1);
-}
-
-// Memoized Recursive Solution
-std::string createKey(int start, int end) {
-    return std::to_string(start) + "," + std::to_string(end);
-}
-
-std::optional<std::pair<int, int>> findPairRecursivelyMemo(
-    const std::vector<int>& arr, int target, int start, int end,
-    std::unordered_map<std::string, std::optional<std::pair<int, int>>>& memo) {
-    if (start >= end) {
-        return std::nullopt;
-    }
-    std::string key = createKey(start, end);
-    if (memo.find(key) != memo.end()) {
-        return memo[key];
-    }
-    if (arr[start] + arr[end] == target) {
-        auto result = std::make_optional(std::make_pair(arr[start], arr[end]));
-        memo[key] = result;
-        return result;
-    }
-    auto result = findPairRecursivelyMemo(arr, target, start + 1, end, memo);
-    if (result) {
-        memo[key] = result;
-        return result;
-    }
-    result = findPairRecursivelyMemo(arr, target, start, end - 1, memo);
-    memo[key] = result;
-    return result;
-}
-
-std::optional<std::pair<int, int>> ValuesMemoized(const std::vector<int>& sequence, int targetSum) {
-    std::unordered_map<std::string, std::optional<std::pair<int, int>>> memo;
-    return findPairRecursivelyMemo(sequence, targetSum, 0, sequence.size() - 1, memo);
-}
-
-// Tabulation Solution
-std::optional<std::pair<int, int>> ValuesTabulation(const std::vector<int>& sequence, int targetSum) {
-    std::unordered_map<int, int> table;
-    for (int i = 0; i < sequence.size(); ++i) {
-        int complement = targetSum - sequence[i];
-        if (table.find(complement) != table.end()) {
-            return std::make_optional(std::make_pair(sequence[i], complement));
-        }
-        table[sequence[i]] = i;
-    }
-    return std::nullopt;
-}
-
-// Tabulation Solution using C-style arrays
-int* ValuesTabulationCStyle(const int* sequence, int length, int targetSum) {
-    const int MAX_VAL = 1000; // Assuming the values in the sequence are less than 1000
-    static int result[2] = { -1, -1 }; // Static array to return the result
-    int table[MAX_VAL];
-    memset(table, -1, sizeof(table));
-
-    for (int i = 0; i < length; ++i) {
-        int complement = targetSum - sequence[i];
-        if (complement >= 0 && table[complement] != -1) {
-            result[0] = sequence[i];
-            result[1] = complement;
-            return result;
-        }
-        table[sequence[i]] = i;
-    }
-    return result;
-}
-
-int main() {
+int main(int argc, char* argv[]) {
     std::vector<int> sequence = { 8, 10, 2, 9, 7, 5 };; // 40 numbers
     int targetSum = 11;
-    int iterations = 1000;
+    BenchmarkRunner runner(argc, argv);
+    long long max_n = runner.int_option("--max-n", 100000000);
 
     std::cout << "-----------------------------------\n";
     std::cout << "Calculating Two-Sum (" << targetSum << ")\n";
+    runner.set_input(std::to_string(sequence.size()));
+
+    // Measure execution time for Brute Force Solution
+    runner.run("Brute Force", [&] {
+        return ValuesBruteForce(sequence, targetSum);
+        });
+
+    // Measure execution time for Naive Recursive Solution
+    runner.run("Recursive", [&] {
+        return ValuesRecursive(sequence, targetSum);
+        });
+
+    // Measure execution time for Memoized Recursive Solution
+    runner.run("Memoized", [&] {
+        return ValuesMemoizedStringKeys(sequence, targetSum);
+        });
+
+    // Measure execution time for Memoized Recursive Solution on the dense triangle memo
+    runner.run("Memoized Triangle", [&] {
+        return ValuesMemoized(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution
+    runner.run("Tabulation", [&] {
+        return ValuesTabulation(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution using C-style arrays
+    runner.run("Tabulation C-Style", [&] {
+        return ValuesTabulationCStyle(sequence.data(), sequence.size(), targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution on a bounds-checked direct-address table
+    runner.run("Tabulation Direct", [&] {
+        return ValuesTabulationDirect(sequence, targetSum);
+        });
+
+    // Random even values with an odd target have no pair, so every element is
+    // scanned: values below 1000 (what the C-style table assumes), values below n
+    // (a direct-address table of ~n entries) and 30-bit values (hashed)
+    struct ValueRange {
+        const char* name;
+        long long limit;  // 0 means n
+    };
+    std::mt19937 rng(42);
+    for (ValueRange range : { ValueRange{ "values < 1000", 1000 }, ValueRange{ "values < n", 0 },
+        ValueRange{ "values < 2^30", 1 << 30 } }) {
+        for (long long n = 1000; n <= max_n; n *= 10) {
+            long long limit = range.limit ? range.limit : n;
+            std::uniform_int_distribution<int> value(0, static_cast<int>(limit / 2 - 1));
+            sequence.resize(n);
+            for (auto& v : sequence) v = 2 * value(rng);
+            int missingSum = 1;
+
+            std::cout << "-----------------------------------\n";
+            std::cout << "Calculating Two-Sum of " << n << " random " << range.name << ", no pair\n";
+            runner.set_input(std::to_string(n) + ", " + range.name);
+            double items = static_cast<double>(n);
+
+            runner.run("Tabulation Flat", [&] {
+                return ValuesTabulationFlat(sequence, missingSum);
+                }, items);
+            runner.run("Tabulation Direct", [&] {
+                return ValuesTabulationDirect(sequence, missingSum);
+                }, items);
+            if (limit <= 1000) {
+                runner.run("Tabulation C-Style", [&] {
+                    return ValuesTabulationCStyle(sequence.data(), sequence.size(), missingSum)[0];
+                    }, items);
+            }
 
-    // Measure average execution time for Brute Force Solution
-    auto bruteForceTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesBruteForce(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Brute Force: " << bruteForceTime << " ns\n";
-
-    // Measure average execution time for Naive Recursive Solution
-    auto recursiveTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesRecursive(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Recursive: " << recursiveTime << " ns\n";
-
-    // Measure average execution time for Memoized Recursive Solution
-    auto memoizedTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesMemoized(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Memoized: " << memoizedTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution
-    auto tabulationTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesTabulation(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Tabulation: " << tabulationTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution using C-style arrays
-    auto tabulationCStyleTime = average_time([](const int* seq, int length, int target) {
-        ValuesTabulationCStyle(seq, length, target);
-        }, iterations, sequence.data(), sequence.size(), targetSum);
-    std::cout << "Average time for Tabulation C-Style: " << tabulationCStyleTime << " ns\n";
+            // A pair that exists must come out the same as from the hashed table
+            std::uniform_int_distribution<long long> index(0, n - 1);
+            int pairSum = sequence[index(rng)] + sequence[index(rng)];
+            if (ValuesTabulationDirect(sequence, missingSum)
+                || ValuesTabulationDirect(sequence, pairSum) != ValuesTabulationFlat(sequence, pairSum)) {
+                std::cout << "Mismatch: direct-address table disagrees with the flat hash table\n";
+            }
+        }
+    }
 
     std::cout << "-----------------------------------\n";
 
     return 0;
 }
-        
\ No newline at end of file
@@ -5,9 +5,9 @@
 
 // Function to find a pair of numbers that add up to the target sum using tabulation
 std::optional<std::pair<int, int>> ValuesTabulation(const std::vector<int>& sequence, int targetSum) {
-    std::unordered_map<int, int> table; // Hash table to store elements and their indices
+    std::unordered_map<int, size_t> table; // Hash table to store elements and their indices
 
-    for (int i = 0; i < sequence.size(); ++i) {
+    for (size_t i = 0; i < sequence.size(); ++i) {
         int complement = targetSum - sequence[i];
 
         // Check if the complement exists in the hash table
@@ -1,28 +1,10 @@
 #include <iostream>
+#include <string>
 #include <vector>
 #include <array>
-#include <chrono>
 #include <cstring> // Para usar memset
 
-// Function to measure execution time
-template <typename Func, typename... Args>
-long long measure_time(Func func, Args&&... args) {
-    auto start = std::chrono::high_resolution_clock::now();
-    func(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<long long, std::nano> duration = end - start;
-    return duration.count();
-}
-
-// Function to calculate average execution time
-template <typename Func, typename... Args>
-long long average_time(Func func, int iterations, Args&&... args) {
-    long long total_time = 0;
-    for (int i = 0; i < iterations; ++i) {
-        total_time += measure_time(func, std::forward<Args>(args)...);
-    }
-    return total_time / iterations;
-}
+#include "Benchmark.h"
 
 // Brute Force Solution
 std::array<int, 2> ValuesBruteForce(const std::vector<int>& sequence, int targetSum) {
@@ -56,36 +38,38 @@ std::array<int, 2> ValuesRecursive(const std::vector<int>& sequence, int targetS
     return findPairRecursively(sequence, targetSum, 0, sequence.size() - 1);
 }
 
-// Memoized Recursive Solution
+// Memoized Recursive Solution. memo is an n x n table flattened row by row, so
+// the result for (start, end) is memo[start * n + end]; {-1, -1} is a valid
+// result (no pair), so known marks the entries already filled in.
 std::array<int, 2> findPairRecursivelyMemo(
     const std::vector<int>& arr, int target, int start, int end,
-    std::array<std::array<int, 2>, 1000>& memo) {
+    std::vector<std::array<int, 2>>& memo, std::vector<char>& known) {
     if (start >= end) {
         return { -1, -1 };
     }
-    if (memo[start][end][0] != -1) {
-        return memo[start][end];
+    size_t cell = size_t(start) * arr.size() + end;
+    if (known[cell]) {
+        return memo[cell];
     }
+    std::array<int, 2> result = { -1, -1 };
     if (arr[start] + arr[end] == target) {
-        memo[start][end] = { arr[start], arr[end] };
-        return { arr[start], arr[end] };
+        result = { arr[start], arr[end] };
     }
-    std::array<int, 2> result = findPairRecursivelyMemo(arr, target, start + 1, end, memo);
-    if (result[0] != -1) {
-        memo[start][end] = result;
-        return result;
+    else {
+        result = findPairRecursivelyMemo(arr, target, start + 1, end, memo, known);
+        if (result[0] == -1) {
+            result = findPairRecursivelyMemo(arr, target, start, end - 1, memo, known);
+        }
     }
-    result = findPairRecursivelyMemo(arr, target, start, end - 1, memo);
-    memo[start][end] = result;
+    memo[cell] = result;
+    known[cell] = 1;
     return result;
 }
 
 std::array<int, 2> ValuesMemoized(const std::vector<int>& sequence, int targetSum) {
-    std::array<std::array<int, 2>, 1000> memo;
-    for (auto& row : memo) {
-        row = { -1, -1 };
-    }
-    return findPairRecursivelyMemo(sequence, targetSum, 0, sequence.size() - 1, memo);
+    std::vector<std::array<int, 2>> memo(sequence.size() * sequence.size());
+    std::vector<char> known(memo.size(), 0);
+    return findPairRecursivelyMemo(sequence, targetSum, 0, sequence.size() - 1, memo, known);
 }
 
 // Tabulation Solution using C-style arrays
@@ -107,37 +91,34 @@ std::array<int, 2> ValuesTabulationCStyle(const int* sequence, int length, int t
     return result;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     std::vector<int> sequence = { 8, 10, 2, 9, 7, 5 }; // Example sequence
     int targetSum = 11;
-    int iterations = 1000;
+    BenchmarkRunner runner(argc, argv);
 
     std::cout << "-----------------------------------\n";
     std::cout << "Calculating Two-Sum (" << targetSum << ")\n";
-
-    // Measure average execution time for Brute Force Solution
-    auto bruteForceTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesBruteForce(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Brute Force: " << bruteForceTime << " ns\n";
-
-    // Measure average execution time for Naive Recursive Solution
-    auto recursiveTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesRecursive(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Recursive: " << recursiveTime << " ns\n";
-
-    // Measure average execution time for Memoized Recursive Solution
-    auto memoizedTime = average_time([](const std::vector<int>& seq, int target) {
-        ValuesMemoized(seq, target);
-        }, iterations, sequence, targetSum);
-    std::cout << "Average time for Memoized: " << memoizedTime << " ns\n";
-
-    // Measure average execution time for Tabulation Solution using C-style arrays
-    auto tabulationCStyleTime = average_time([](const int* seq, int length, int target) {
-        ValuesTabulationCStyle(seq, length, target);
-        }, iterations, sequence.data(), sequence.size(), targetSum);
-    std::cout << "Average time for Tabulation C-Style: " << tabulationCStyleTime << " ns\n";
+    runner.set_input(std::to_string(sequence.size()));
+
+    // Measure execution time for Brute Force Solution
+    runner.run("Brute Force", [&] {
+        return ValuesBruteForce(sequence, targetSum);
+        });
+
+    // Measure execution time for Naive Recursive Solution
+    runner.run("Recursive", [&] {
+        return ValuesRecursive(sequence, targetSum);
+        });
+
+    // Measure execution time for Memoized Recursive Solution
+    runner.run("Memoized", [&] {
+        return ValuesMemoized(sequence, targetSum);
+        });
+
+    // Measure execution time for Tabulation Solution using C-style arrays
+    runner.run("Tabulation C-Style", [&] {
+        return ValuesTabulationCStyle(sequence.data(), sequence.size(), targetSum);
+        });
 
     std::cout << "-----------------------------------\n";
 
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ThreadPool.h"
+#include "TwoSum.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long elements = runner.int_option("--elements", 100000);
+    long long queries = runner.int_option("--queries", 1000);
+    long long max_threads = runner.int_option("--max-threads", std::thread::hardware_concurrency());
+    if (max_threads < 1) max_threads = 1;
+
+    // Powers of two up to the core count, then the core count itself
+    std::vector<int> thread_counts;
+    for (int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(static_cast<int>(max_threads));
+
+    // Values below 4n take the bitset path of the index, 30-bit values the sorted one
+    struct ValueRange {
+        const char* name;
+        long long limit;
+    };
+    std::mt19937 rng(42);
+    for (ValueRange range : { ValueRange{ "values < 4n", 4 * elements }, ValueRange{ "values < 2^30", 1 << 30 } }) {
+        std::uniform_int_distribution<int> value(0, static_cast<int>(range.limit - 1));
+        std::vector<int> sequence(elements);
+        for (auto& v : sequence) v = value(rng);
+
+        // Half of the targets are sums of two elements, half are random
+        std::uniform_int_distribution<long long> index(0, elements - 1);
+        std::vector<int> targets(queries);
+        for (long long q = 0; q < queries; ++q) {
+            targets[q] = q % 2 ? sequence[index(rng)] + sequence[index(rng)] : 2 * value(rng);
+        }
+        std::vector<std::optional<std::pair<int, int>>> results(queries);
+
+        std::cout << "-----------------------------------\n";
+        std::cout << queries << " Two-Sum queries over " << elements << " " << range.name << "\n";
+        runner.set_input(std::to_string(elements) + ", " + range.name);
+        double items = static_cast<double>(queries);
+
+        // Every existing entry point builds its table again for each target
+        runner.run("rebuild Tabulation Flat per query", [&] {
+            for (long long q = 0; q < queries; ++q) results[q] = ValuesTabulationFlat(sequence, targets[q]);
+            return results[0];
+            }, items);
+        std::vector<bool> found(queries);
+        for (long long q = 0; q < queries; ++q) found[q] = results[q].has_value();
+
+        runner.run("TwoSumIndex build", [&] {
+            return TwoSumIndex(sequence).query(0);
+            });
+        TwoSumIndex twoSumIndex(sequence);
+
+        runner.run("TwoSumIndex, no pool", [&] {
+            twoSumIndex.query(targets, results);
+            return results[0];
+            }, items);
+
+        for (int threads : thread_counts) {
+            ThreadPool pool(threads);
+            runner.set_input(std::to_string(elements) + ", " + range.name + ", " + std::to_string(threads) + " threads");
+            runner.run("TwoSumIndex", [&] {
+                twoSumIndex.query(targets, results, &pool);
+                return results[0];
+                }, items);
+        }
+
+        // Same answer as rebuilding, up to which of several pairs is returned
+        for (long long q = 0; q < queries; ++q) {
+            if (results[q].has_value() != found[q] || (results[q] && results[q]->first + results[q]->second != targets[q])) {
+                std::cout << "Mismatch: TwoSumIndex disagrees with ValuesTabulationFlat for target " << targets[q] << "\n";
+                break;
+            }
+        }
+    }
+
+    std::cout << "-----------------------------------\n";
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TwoSum.h"
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner(argc, argv);
+    long long stream_length = runner.int_option("--elements", 10000000);
+    long long max_window = runner.int_option("--max-window", 1000000);
+    long long max_scan_window = runner.int_option("--max-scan-window", 1000);
+
+    // 24-bit values and a target in the middle of the sum range, so pairs turn
+    // up more often as the window grows
+    const int64_t targetSum = 1 << 24;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> value(0, (1 << 24) - 1);
+    std::vector<int64_t> stream(stream_length);
+    for (auto& v : stream) v = value(rng);
+
+    for (long long window = 10; window <= max_window; window *= 10) {
+        WindowedTwoSum check(targetSum, window);
+        std::cout << "-----------------------------------\n";
+        std::cout << "Two-Sum over the last " << window << " of " << stream_length << " elements, "
+            << check.memory_bytes() << " bytes of state\n";
+        runner.set_input(std::to_string(window) + " window");
+        double items = static_cast<double>(stream_length);
+
+        // Number of elements that complete a pair, so no push can be skipped
+        runner.run("WindowedTwoSum", [&] {
+            WindowedTwoSum pairs(targetSum, window);
+            long long hits = 0;
+            for (int64_t x : stream) hits += pairs.push(x).has_value();
+            return hits;
+            }, items);
+
+        // Scanning the ring for the complement costs O(window) per element
+        if (window <= max_scan_window) {
+            runner.run("ring buffer scan", [&] {
+                std::vector<int64_t> ring(window);
+                size_t next = 0, size = 0;
+                long long hits = 0;
+                for (int64_t x : stream) {
+                    bool hit = false;
+                    for (size_t k = 0; k < size; ++k) hit |= ring[k] + x == targetSum;
+                    hits += hit;
+                    ring[next] = x;
+                    next = next + 1 == ring.size() ? 0 : next + 1;
+                    size += size < ring.size();
+                }
+                return hits;
+                }, items);
+
+            long long expected = 0, hits = 0;
+            std::vector<int64_t> ring(window);
+            size_t next = 0, size = 0;
+            for (int64_t x : stream) {
+                bool hit = false;
+                for (size_t k = 0; k < size; ++k) hit |= ring[k] + x == targetSum;
+                expected += hit;
+                hits += check.push(x).has_value();
+                ring[next] = x;
+                next = next + 1 == ring.size() ? 0 : next + 1;
+                size += size < ring.size();
+            }
+            if (hits != expected) std::cout << "Mismatch: WindowedTwoSum disagrees with scanning the window\n";
+        }
+    }
+
+    std::cout << "-----------------------------------\n";
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+# Writes the current git revision to OUTPUT, touching the file only when it changes.
+# Usage: cmake -DSOURCE_DIR=<repo> -DOUTPUT=<header> -P GitRevision.cmake
+execute_process(
+    COMMAND git rev-parse HEAD
+    WORKING_DIRECTORY "${SOURCE_DIR}"
+    OUTPUT_VARIABLE revision
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    RESULT_VARIABLE result
+    ERROR_QUIET)
+if(NOT result EQUAL 0)
+    set(revision "unknown")
+else()
+    execute_process(
+        COMMAND git diff --quiet HEAD --
+        WORKING_DIRECTORY "${SOURCE_DIR}"
+        RESULT_VARIABLE dirty
+        ERROR_QUIET)
+    if(NOT dirty EQUAL 0)
+        string(APPEND revision "-dirty")
+    endif()
+endif()
+
+set(content "#pragma once\n\n#define DP_GIT_REVISION \"${revision}\"\n")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+endif()
+if(NOT "${content}" STREQUAL "${previous}")
+    file(WRITE "${OUTPUT}" "${content}")
+endif()